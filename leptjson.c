@@ -15,11 +15,47 @@
 #include <math.h>    /* HUGE_VAL */
 #include <string.h>  /* memcpy */
 #include <stdio.h>
+#include <stdint.h>  /* uint64_t */
+#include <float.h>   /* FLT_EVAL_METHOD */
 
 #ifndef LEPT_PARSE_STACK_INIT_SIZE
 #define LEPT_PARSE_STACK_INIT_SIZE 256  // 栈初始大小
 #endif
 
+#ifndef LEPT_ARENA_CHUNK_SIZE
+#define LEPT_ARENA_CHUNK_SIZE 4096      // arena块的默认大小
+#endif
+
+#define LEPT_ARENA_ALIGN 8              // arena分配的对齐字节数
+
+#ifndef LEPT_OBJECT_HASH_THRESHOLD
+#define LEPT_OBJECT_HASH_THRESHOLD 16   // 成员数达到此值的对象建立哈希索引
+#endif
+
+#ifndef LEPT_PACKED_ARRAY_THRESHOLD
+#define LEPT_PACKED_ARRAY_THRESHOLD 16  // 元素数达到此值的纯数字数组存为连续的double
+#endif
+
+#ifndef LEPT_KEYPOOL_INIT_SIZE
+#define LEPT_KEYPOOL_INIT_SIZE 64       // 键池哈希表的初始槽数（2的幂）
+#endif
+
+#ifndef LEPT_SIZE_MAX                   // 字符串和数组/对象长度的上限，超过时解析失败（LEPT_PARSE_TOO_LARGE）
+#ifdef LEPT_COMPACT_VALUE
+#define LEPT_SIZE_MAX UINT32_MAX        // 紧凑布局的长度只有32位
+#else
+#define LEPT_SIZE_MAX SIZE_MAX
+#endif
+#endif
+
+#ifndef LEPT_VALIDATE_DEPTH
+#define LEPT_VALIDATE_DEPTH 1024        // lept_validate 在一个栈帧内记录的嵌套层数（64的倍数），更深时递归
+#endif
+
+#ifndef LEPT_STRINGIFY_BUFFER_SIZE
+#define LEPT_STRINGIFY_BUFFER_SIZE 65536 // 流式输出缓冲区的默认大小
+#endif
+
 
 /*
 * 关于assert：
@@ -28,45 +64,171 @@
 * 断言失败会直接令程序崩溃。
 */
 #define EXPECT(c, ch)       do { assert(*c->json == (ch)); c->json++; } while (0)
+#define PEEK(c)             ((c)->json < (c)->end ? *(c)->json : '\0')  // 越过末尾时返回'\0'
 #define ISDIGIT(ch)         ((ch) >= '0' && (ch) <= '9')
 #define ISDIGIT1TO9(ch)     ((ch) >= '1' && (ch) <= '9')
 #define ISHEXDIGIT(ch)      (ISDIGIT(ch) || ((ch) >= 'a' && (ch) <= 'f') || ((ch) >= 'A' && (ch) <= 'F'))
 #define ISWHITESPACE(ch)    ((ch) == ' ' || (ch) == '\t' || (ch) == '\n' || (ch) == '\r')
-#define STRING_ERROR(ret)   do { c->top = 0; return ret; } while (0)
+#define STRING_ERROR(ret)   do { c->top = head; return ret; } while (0)  // 只弹出本字符串压入的字节
 #define ARRARY_ERROR(ret) \
     do {\
         for (size_t i = 0; i < size; i++)\
             lept_free((lept_value*)lept_context_pop(c, sizeof(lept_value)));\
-        c->top = 0;\
         return ret;\
     } while (0)
 
+/*
+ * 数组/对象的容量。紧凑布局的值里放不下容量：堆上的元素/成员数组前面多分配一个 size_t 记录它，
+ * 借用的数组（来自arena）没有这个头部，容量总是等于大小
+ */
+#ifdef LEPT_COMPACT_VALUE
+#define LEPT_HEAP_HEADER        sizeof(size_t)
+#define LEPT_HEAP_CAPACITY(v, p) ((v)->u.p ? ((size_t*)(v)->u.p)[-1] : 0)
+#define LEPT_ARRAY_CAPACITY(v)  ((v)->flags & LEPT_FLAG_BORROWED ? (size_t)(v)->u.a.size : LEPT_HEAP_CAPACITY(v, a.e))
+#define LEPT_OBJECT_CAPACITY(v) ((v)->flags & LEPT_FLAG_BORROWED ? (size_t)(v)->u.o.size : LEPT_HEAP_CAPACITY(v, o.m))
+#define LEPT_SET_HEAP_CAPACITY(v, p, n) \
+    do { if (!((v)->flags & LEPT_FLAG_BORROWED) && (v)->u.p) ((size_t*)(v)->u.p)[-1] = (n); } while (0)
+#define LEPT_SET_ARRAY_CAPACITY(v, n)   LEPT_SET_HEAP_CAPACITY(v, a.e, n)
+#define LEPT_SET_OBJECT_CAPACITY(v, n)  LEPT_SET_HEAP_CAPACITY(v, o.m, n)
+#else
+#define LEPT_HEAP_HEADER        0
+#define LEPT_ARRAY_CAPACITY(v)  ((v)->u.a.capacity)
+#define LEPT_OBJECT_CAPACITY(v) ((v)->u.o.capacity)
+#define LEPT_SET_ARRAY_CAPACITY(v, n)   ((v)->u.a.capacity = (n))
+#define LEPT_SET_OBJECT_CAPACITY(v, n)  ((v)->u.o.capacity = (n))
+#endif
+
+// 长度能否存入 lept_size（不超过 LEPT_SIZE_MAX）
+#define LEPT_SIZE_FITS(n)   ((size_t)(n) <= (size_t)LEPT_SIZE_MAX)
+
+// 懒惰解析的容器在首次访问时展开一层，值的内容不变
+#define LEPT_MATERIALIZE(v) do { if ((v)->flags & LEPT_FLAG_LAZY) lept_materialize((lept_value*)(v)); } while (0)
+
+// 紧凑的数字数组（LEPT_FLAG_PACKED）中 u.a.e 实际指向 double，容量也按 double 计
+#define LEPT_PACKED(v)          ((double*)(v)->u.a.e)
+#define LEPT_ELEMENT_SIZE(v)    ((v)->flags & LEPT_FLAG_PACKED ? sizeof(double) : sizeof(lept_value))
+
 #define OBJECT_ERROR(ret) \
     do {\
         lept_member* rm;\
         for (size_t i = 0; i < size; i++) {\
             rm = (lept_member*)lept_context_pop(c, sizeof(lept_member));\
-            free(rm->k);\
+            lept_context_free(c, rm->k);\
             lept_free(&rm->v);\
         }\
-        c->top = 0;\
         return ret;\
     } while (0)
 
-#define PUTS(c, s, len)  memcpy(lept_context_push_len(c, len), s, len)
+#define PUTS(c, s, len)  lept_context_puts(c, s, len)
+
+
+/* arena的一块内存，块头之后紧跟可分配区域 */
+struct t_lept_arena_chunk {
+    lept_arena_chunk* next;
+    size_t size, used;  // 可分配区域大小、已用字节数
+};
+
+#define ARENA_ROUND(n)      (((n) + LEPT_ARENA_ALIGN - 1) & ~(size_t)(LEPT_ARENA_ALIGN - 1))
+#define ARENA_CHUNK_HEADER  ARENA_ROUND(sizeof(lept_arena_chunk))
+#define ARENA_CHUNK_DATA(k) ((char*)(k) + ARENA_CHUNK_HEADER)
+
+void lept_arena_init(lept_arena* a, size_t chunk_size) {
+    assert(a != NULL);
+    a->head = NULL;
+    a->chunk_size = chunk_size ? chunk_size : LEPT_ARENA_CHUNK_SIZE;
+}
+
+void* lept_arena_alloc(lept_arena* a, size_t size) {
+    lept_arena_chunk* k;
+    assert(a != NULL);
+    size = ARENA_ROUND(size);
+    k = a->head;
+    if (k == NULL || k->size - k->used < size) {
+        // 新块至少是上一块的两倍，使大文档的块数按对数增长
+        size_t n = k ? k->size * 2 : a->chunk_size;
+        if (n < size)
+            n = size;
+        k = (lept_arena_chunk*)malloc(ARENA_CHUNK_HEADER + n);
+        k->size = n;
+        k->used = 0;
+        k->next = a->head;
+        a->head = k;
+    }
+    k->used += size;
+    return ARENA_CHUNK_DATA(k) + k->used - size;
+}
+
+void lept_arena_reset(lept_arena* a) {
+    lept_arena_chunk *k, *next, *keep = NULL;
+    assert(a != NULL);
+    for (k = a->head; k; k = next) {
+        next = k->next;
+        if (keep == NULL || k->size > keep->size) {
+            free(keep);
+            keep = k;
+        } else
+            free(k);
+    }
+    if (keep) {
+        keep->used = 0;
+        keep->next = NULL;
+    }
+    a->head = keep;
+}
 
+void lept_arena_free(lept_arena* a) {
+    lept_arena_reset(a);
+    free(a->head);
+    a->head = NULL;
+}
 
-static void lept_context_init(lept_context* c, const char* json) {
+static void lept_context_init(lept_context* c, const char* json, size_t len) {
     c->json = json;
+    c->end = json + len;
     c->size = LEPT_PARSE_STACK_INIT_SIZE;
     c->stack = (char*)malloc(sizeof(char) * c->size);
     c->top = 0;
+    c->arena = NULL;
+    c->insitu = 0;
+    c->keys = NULL;
+    c->lazy = 0;
+    c->proj = NULL;
+    c->handler = NULL;
+    c->user = NULL;
+    c->write = NULL;
+    c->pretty = 0;
+    c->fixed = 0;
+}
+
+// 为解析结果分配内存：arena模式下从arena分配，否则用malloc
+static void* lept_context_alloc(lept_context* c, size_t size) {
+    return c->arena ? lept_arena_alloc(c->arena, size) : malloc(size);
+}
+
+static void lept_context_free(lept_context* c, void* p) {
+    if (!c->arena && !c->insitu && !c->keys)
+        free(p);
+}
+
+// 分配/释放堆上的元素或成员数组，紧凑布局下连同记录容量的头部一起
+static void* lept_heap_realloc(void* p, size_t bytes) {
+    char* base = (char*)realloc(p ? (char*)p - LEPT_HEAP_HEADER : NULL, LEPT_HEAP_HEADER + bytes);
+    return base ? base + LEPT_HEAP_HEADER : NULL;
+}
+
+static void lept_heap_free(void* p) {
+    if (p)
+        free((char*)p - LEPT_HEAP_HEADER);
 }
 
 // 与一般push不同，这里压入len个字节，类型待定，因此用到void *指向该待赋值区域
 static void* lept_context_push_len(lept_context* c, size_t len) {
     void* ret;
     while (c->size < c->top + len) {
+        if (c->fixed) {  // 调用者的缓冲区不能增长：记为放不下，丢弃这次输出
+            c->top = c->size + 1;
+            return NULL;
+        }
         c->size += c->size >> 1;  // <=> *1.5
         c->stack = (char*)realloc(c->stack, c->size);
     }
@@ -79,12 +241,23 @@ static void* lept_context_push_len(lept_context* c, size_t len) {
 static void lept_context_push(lept_context* c, const char ch) {
     // 如果溢栈，需要重新分配内存
     if (c->size < c->top + 1) {
+        if (c->fixed) {
+            c->top = c->size + 1;
+            return;
+        }
         c->size += c->size >> 1;  // <=> *1.5
         c->stack = (char*)realloc(c->stack, c->size);
     }
     c->stack[(c->top)++] = ch;
 }
 
+// 压入 len 个字节，调用者的缓冲区放不下时不写入
+static void lept_context_puts(lept_context* c, const char* s, size_t len) {
+    char* p = (char*)lept_context_push_len(c, len);
+    if (p != NULL)
+        memcpy(p, s, len);
+}
+
 // 与一般pop不同，这里弹出前len个值
 static char* lept_context_pop(lept_context* c, size_t len) {
     assert(c->top >= len);
@@ -92,12 +265,350 @@ static char* lept_context_pop(lept_context* c, size_t len) {
     return c->stack + c->top;
 }
 
+/*
+* 字符扫描：跳过空白、查找字符串中下一个需要特别处理的字节（'"'、'\\'、控制字符）
+* x86上一次比较16（SSE2）或32（AVX2）字节，AVX2在运行时检测；其余平台和不足一个向量的尾部逐字节处理
+* 定义 LEPT_NO_SIMD 可以关闭向量实现
+*/
+#if !defined(LEPT_NO_SIMD) && (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || (defined(__i386__) && defined(__SSE2__)))
+#define LEPT_SIMD_X86
+#include <immintrin.h>
+#endif
+
+static const char* lept_skip_whitespace_scalar(const char* p, const char* end) {
+    while (p < end && ISWHITESPACE(*p))
+        p++;
+    return p;
+}
+
+static const char* lept_scan_string_scalar(const char* p, const char* end) {
+    while (p < end && *p != '\"' && *p != '\\' && (unsigned char)*p >= 0x20)
+        p++;
+    return p;
+}
+
+#ifdef LEPT_SIMD_X86
+static const char* lept_skip_whitespace_sse2(const char* p, const char* end) {
+    const __m128i sp = _mm_set1_epi8(' '), tab = _mm_set1_epi8('\t');
+    const __m128i lf = _mm_set1_epi8('\n'), cr = _mm_set1_epi8('\r');
+    for (; end - p >= 16; p += 16) {
+        __m128i x = _mm_loadu_si128((const __m128i*)p);
+        __m128i ws = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(x, sp), _mm_cmpeq_epi8(x, tab)),
+                                  _mm_or_si128(_mm_cmpeq_epi8(x, lf), _mm_cmpeq_epi8(x, cr)));
+        unsigned mask = (unsigned)_mm_movemask_epi8(ws) ^ 0xFFFFu;  // 非空白的位置
+        if (mask)
+            return p + __builtin_ctz(mask);
+    }
+    return lept_skip_whitespace_scalar(p, end);
+}
+
+static const char* lept_scan_string_sse2(const char* p, const char* end) {
+    const __m128i quote = _mm_set1_epi8('\"'), backslash = _mm_set1_epi8('\\'), ctrl = _mm_set1_epi8(0x1F);
+    for (; end - p >= 16; p += 16) {
+        __m128i x = _mm_loadu_si128((const __m128i*)p);
+        // 无符号比较 x <= 0x1F 等价于 max(x, 0x1F) == 0x1F
+        __m128i hit = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(x, quote), _mm_cmpeq_epi8(x, backslash)),
+                                   _mm_cmpeq_epi8(_mm_max_epu8(x, ctrl), ctrl));
+        unsigned mask = (unsigned)_mm_movemask_epi8(hit);
+        if (mask)
+            return p + __builtin_ctz(mask);
+    }
+    return lept_scan_string_scalar(p, end);
+}
+
+__attribute__((target("avx2")))
+static const char* lept_skip_whitespace_avx2(const char* p, const char* end) {
+    const __m256i sp = _mm256_set1_epi8(' '), tab = _mm256_set1_epi8('\t');
+    const __m256i lf = _mm256_set1_epi8('\n'), cr = _mm256_set1_epi8('\r');
+    for (; end - p >= 32; p += 32) {
+        __m256i x = _mm256_loadu_si256((const __m256i*)p);
+        __m256i ws = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(x, sp), _mm256_cmpeq_epi8(x, tab)),
+                                     _mm256_or_si256(_mm256_cmpeq_epi8(x, lf), _mm256_cmpeq_epi8(x, cr)));
+        unsigned mask = ~(unsigned)_mm256_movemask_epi8(ws);
+        if (mask)
+            return p + __builtin_ctz(mask);
+    }
+    return lept_skip_whitespace_sse2(p, end);
+}
+
+__attribute__((target("avx2")))
+static const char* lept_scan_string_avx2(const char* p, const char* end) {
+    const __m256i quote = _mm256_set1_epi8('\"'), backslash = _mm256_set1_epi8('\\'), ctrl = _mm256_set1_epi8(0x1F);
+    for (; end - p >= 32; p += 32) {
+        __m256i x = _mm256_loadu_si256((const __m256i*)p);
+        __m256i hit = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(x, quote), _mm256_cmpeq_epi8(x, backslash)),
+                                      _mm256_cmpeq_epi8(_mm256_max_epu8(x, ctrl), ctrl));
+        unsigned mask = (unsigned)_mm256_movemask_epi8(hit);
+        if (mask)
+            return p + __builtin_ctz(mask);
+    }
+    return lept_scan_string_sse2(p, end);
+}
+
+static const char* lept_skip_whitespace_resolve(const char* p, const char* end);
+static const char* lept_scan_string_resolve(const char* p, const char* end);
+
+// 第一次调用时检测CPU并替换为对应的实现，重复检测的结果相同，并发初始化无害
+static const char* (*lept_skip_whitespace_impl)(const char*, const char*) = lept_skip_whitespace_resolve;
+static const char* (*lept_scan_string_impl)(const char*, const char*) = lept_scan_string_resolve;
+
+static void lept_simd_resolve(void) {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        lept_skip_whitespace_impl = lept_skip_whitespace_avx2;
+        lept_scan_string_impl = lept_scan_string_avx2;
+    } else {
+        lept_skip_whitespace_impl = lept_skip_whitespace_sse2;
+        lept_scan_string_impl = lept_scan_string_sse2;
+    }
+}
+
+static const char* lept_skip_whitespace_resolve(const char* p, const char* end) {
+    lept_simd_resolve();
+    return lept_skip_whitespace_impl(p, end);
+}
+
+static const char* lept_scan_string_resolve(const char* p, const char* end) {
+    lept_simd_resolve();
+    return lept_scan_string_impl(p, end);
+}
+#endif
+
+// 返回 [p, end) 中第一个非空白字符的位置
+static const char* lept_skip_whitespace(const char* p, const char* end) {
+    // 紧凑的JSON里多数位置根本没有空白，缩进通常也只有几个字节，先逐字节处理
+    if (p < end && !ISWHITESPACE(*p))
+        return p;
+#ifdef LEPT_SIMD_X86
+    if (end - p >= 16) {
+        // 缩进多半不超过16字节：先用SSE2看一次，找不到才走分派的内核
+        const __m128i sp = _mm_set1_epi8(' '), tab = _mm_set1_epi8('\t');
+        const __m128i lf = _mm_set1_epi8('\n'), cr = _mm_set1_epi8('\r');
+        __m128i x = _mm_loadu_si128((const __m128i*)p);
+        __m128i ws = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(x, sp), _mm_cmpeq_epi8(x, tab)),
+                                  _mm_or_si128(_mm_cmpeq_epi8(x, lf), _mm_cmpeq_epi8(x, cr)));
+        unsigned mask = (unsigned)_mm_movemask_epi8(ws) ^ 0xFFFFu;
+        if (mask)
+            return p + __builtin_ctz(mask);
+        return lept_skip_whitespace_impl(p + 16, end);
+    }
+#endif
+    return lept_skip_whitespace_scalar(p, end);
+}
+
+// 返回 [p, end) 中第一个 '"'、'\\' 或控制字符的位置
+static const char* lept_scan_string(const char* p, const char* end) {
+#ifdef LEPT_SIMD_X86
+    if (end - p >= 16) {
+        // 键和短字符串多半在前16字节内结束，先用SSE2看一次，免去间接调用
+        const __m128i quote = _mm_set1_epi8('\"'), backslash = _mm_set1_epi8('\\'), ctrl = _mm_set1_epi8(0x1F);
+        __m128i x = _mm_loadu_si128((const __m128i*)p);
+        __m128i hit = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(x, quote), _mm_cmpeq_epi8(x, backslash)),
+                                   _mm_cmpeq_epi8(_mm_max_epu8(x, ctrl), ctrl));
+        unsigned mask = (unsigned)_mm_movemask_epi8(hit);
+        if (mask)
+            return p + __builtin_ctz(mask);
+        return lept_scan_string_impl(p + 16, end);
+    }
+#endif
+    return lept_scan_string_scalar(p, end);
+}
+
+/*
+* 括号配对的位掩码内核：每次取64字节，求出引号、反斜杠和括号各自的64位掩码，
+* 用位运算算出被转义的字节和字符串内部的范围，之后只需数字符串之外的括号，不必逐字节判断状态
+*/
+typedef struct {
+    uint64_t quote, backslash, open, close;  // '"'、'\\'、'['或'{'、']'或'}'
+} lept_block;
+
+static int lept_ctz64(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(x);
+#else
+    int n = 0;
+    for (; !(x & 1); x >>= 1)
+        n++;
+    return n;
+#endif
+}
+
+static int lept_popcount64(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(x);
+#else
+    int n = 0;
+    for (; x; x &= x - 1)
+        n++;
+    return n;
+#endif
+}
+
+static void lept_block_scan(const char* p, lept_block* b) {
+#ifdef LEPT_SIMD_X86
+    // '['|0x20 == '{'、']'|0x20 == '}'，其他字节或上0x20都不会等于它们
+    const __m128i quote = _mm_set1_epi8('\"'), backslash = _mm_set1_epi8('\\');
+    const __m128i lower = _mm_set1_epi8(0x20), open = _mm_set1_epi8('{'), close = _mm_set1_epi8('}');
+    b->quote = b->backslash = b->open = b->close = 0;
+    for (int i = 0; i < 64; i += 16) {
+        __m128i x = _mm_loadu_si128((const __m128i*)(p + i)), y = _mm_or_si128(x, lower);
+        b->quote |= (uint64_t)(unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(x, quote)) << i;
+        b->backslash |= (uint64_t)(unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(x, backslash)) << i;
+        b->open |= (uint64_t)(unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(y, open)) << i;
+        b->close |= (uint64_t)(unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(y, close)) << i;
+    }
+#else
+    b->quote = b->backslash = b->open = b->close = 0;
+    for (int i = 0; i < 64; i++) {
+        uint64_t bit = (uint64_t)1 << i;
+        switch (p[i]) {
+            case '\"': b->quote |= bit; break;
+            case '\\': b->backslash |= bit; break;
+            case '[': case '{': b->open |= bit; break;
+            case ']': case '}': b->close |= bit; break;
+        }
+    }
+#endif
+}
+
+// 被转义的字节：奇数长度的反斜杠序列之后的那个字节。*carry 记录下一块的第一个字节是否被转义
+static uint64_t lept_block_escaped(uint64_t backslash, uint64_t* carry) {
+    const uint64_t even = 0x5555555555555555u;
+    uint64_t follows, odd_starts, sum;
+    backslash &= ~*carry;  // 被转义的反斜杠不开始新序列
+    follows = backslash << 1 | *carry;
+    odd_starts = backslash & ~even & ~follows;  // 从奇数位开始的序列
+    sum = odd_starts + backslash;  // 加法把这些序列进位到它之后的字节，它们的奇偶关系与从偶数位开始的相反
+    *carry = sum < backslash;
+    return (even ^ sum << 1) & follows;
+}
+
+// 前缀异或：第i位是第0..i位的异或，引号之间（含开引号）为1
+static uint64_t lept_prefix_xor(uint64_t x) {
+    x ^= x << 1;
+    x ^= x << 2;
+    x ^= x << 4;
+    x ^= x << 8;
+    x ^= x << 16;
+    x ^= x << 32;
+    return x;
+}
+
+// 块中的空白字节（' '、'\t'、'\n'、'\r'）
+static uint64_t lept_block_whitespace(const char* p) {
+    uint64_t ws = 0;
+#ifdef LEPT_SIMD_X86
+    const __m128i sp = _mm_set1_epi8(' '), tab = _mm_set1_epi8('\t'), lf = _mm_set1_epi8('\n'), cr = _mm_set1_epi8('\r');
+    for (int i = 0; i < 64; i += 16) {
+        __m128i x = _mm_loadu_si128((const __m128i*)(p + i));
+        __m128i hit = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(x, sp), _mm_cmpeq_epi8(x, tab)),
+                                   _mm_or_si128(_mm_cmpeq_epi8(x, lf), _mm_cmpeq_epi8(x, cr)));
+        ws |= (uint64_t)(unsigned)_mm_movemask_epi8(hit) << i;
+    }
+#else
+    for (int i = 0; i < 64; i++)
+        if (ISWHITESPACE(p[i]))
+            ws |= (uint64_t)1 << i;
+#endif
+    return ws;
+}
+
+// 压缩一个整块：把 keep 中为1的字节依次写到 out，返回字节数
+// 会多写几个字节（逐字节版本1个，SSSE3版本至多7个），都不超过 out + 64，且会被之后的输出覆盖；
+// out 可以等于 q（就地压缩），多写的字节落在已经读过的位置
+static size_t lept_compress_block_scalar(char* out, const char* q, uint64_t keep) {
+    size_t n = 0;
+    for (int i = 0; i < 64; i++) {
+        out[n] = q[i];
+        n += keep >> i & 1;
+    }
+    return n;
+}
+
+#ifdef LEPT_SIMD_X86
+static unsigned char lept_compress_table[256][8];  // 8位掩码 => pshufb的下标，空位填0x80（输出0）
+
+__attribute__((target("ssse3")))
+static size_t lept_compress_block_ssse3(char* out, const char* q, uint64_t keep) {
+    size_t n = 0;
+    for (int i = 0; i < 64; i += 8) {
+        unsigned m = (unsigned)(keep >> i) & 0xFF;
+        __m128i x = _mm_loadl_epi64((const __m128i*)(q + i));
+        _mm_storel_epi64((__m128i*)(out + n), _mm_shuffle_epi8(x, _mm_loadl_epi64((const __m128i*)lept_compress_table[m])));
+        n += lept_popcount64(m);
+    }
+    return n;
+}
+
+static size_t lept_compress_block_resolve(char* out, const char* q, uint64_t keep);
+static size_t (*lept_compress_block_impl)(char*, const char*, uint64_t) = lept_compress_block_resolve;
+
+// 与 lept_simd_resolve 相同，重复初始化的结果相同
+static size_t lept_compress_block_resolve(char* out, const char* q, uint64_t keep) {
+    for (int m = 0; m < 256; m++) {
+        int k = 0;
+        for (int i = 0; i < 8; i++)
+            if (m >> i & 1)
+                lept_compress_table[m][k++] = (unsigned char)i;
+        while (k < 8)
+            lept_compress_table[m][k++] = 0x80;
+    }
+    __builtin_cpu_init();
+    lept_compress_block_impl = __builtin_cpu_supports("ssse3") ? lept_compress_block_ssse3 : lept_compress_block_scalar;
+    return lept_compress_block_impl(out, q, keep);
+}
+#endif
+
+static size_t lept_compress_block(char* out, const char* q, uint64_t keep) {
+#ifdef LEPT_SIMD_X86
+    return lept_compress_block_impl(out, q, keep);
+#else
+    return lept_compress_block_scalar(out, q, keep);
+#endif
+}
+
+// *pp 指向 '[' 或 '{'，成功时指向与它配对的右括号之后。不检查括号的种类和其中的内容
+static int lept_match_brackets(const char** pp, const char* end) {
+    const char* p = *pp;
+    uint64_t escaped = 0, in_string = 0, quote, bits;
+    size_t depth = 0;
+    lept_block b;
+    char buf[64];
+    for (; p < end; p += 64) {
+        if (end - p >= 64)
+            lept_block_scan(p, &b);
+        else {  // 尾部补空格凑成一块
+            memset(buf, ' ', sizeof(buf));
+            memcpy(buf, p, end - p);
+            lept_block_scan(buf, &b);
+        }
+        quote = b.quote & ~lept_block_escaped(b.backslash, &escaped);
+        in_string = lept_prefix_xor(quote) ^ in_string;
+        b.open &= ~in_string;
+        b.close &= ~in_string;
+        in_string = 0 - (in_string >> 63);  // 下一块是否从字符串内部开始
+        if ((size_t)lept_popcount64(b.close) < depth) {  // 本块内不可能配平
+            depth += lept_popcount64(b.open) - lept_popcount64(b.close);
+            continue;
+        }
+        for (bits = b.open | b.close; bits; bits &= bits - 1) {
+            int i = lept_ctz64(bits);
+            if (b.open >> i & 1)
+                depth++;
+            else if (--depth == 0) {
+                *pp = p + i + 1;
+                return LEPT_PARSE_OK;
+            }
+        }
+    }
+    if (in_string)
+        return LEPT_PARSE_MISS_QUOTATION_MARK;
+    return **pp == '[' ? LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET : LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET;
+}
+
 // 跳过空白符
 static void lept_parse_whitespace(lept_context* c) {
-    const char *p = c->json;
-    while (ISWHITESPACE(*p))
-        p++;
-    c->json = p;
+    c->json = lept_skip_whitespace(c->json, c->end);
 }
 #if 0
 // 解析"null"
@@ -136,50 +647,726 @@ static int lept_parse_literal(lept_context* c, lept_value* v, const char* litera
     EXPECT(c, literal[0]);
     size_t i = 0;
     for (; literal[i+1]; i++)
-        if (c->json[i] != literal[i+1])
+        if (c->json + i == c->end || c->json[i] != literal[i+1])
             return LEPT_PARSE_INVALID_VALUE;
     c->json += i;
     v->type = type;
     return LEPT_PARSE_OK;
 }
 
-// 解析数字(参考ECMA404-num构成图)
+/*
+* 数字转换：不再调用strtod（与locale有关且慢），结果与正确舍入的strtod逐位相同
+* 1. 语法检查的同时累积至多19位有效数字 w 和十进制指数 e10，数字只扫描一次
+* 2. w 和 10^|e10| 都能用double精确表示时，一次乘除即得正确舍入的结果（Clinger快速路径）
+* 3. 否则用 Eisel-Lemire 算法：w 乘以 10^e10 的128位近似值，能判定舍入方向时直接得到结果
+* 4. 仍无法判定（极少）时，用十进制大数移位的方法精确计算
+*/
+#define LEPT_POW10_MIN (-348)
+#define LEPT_POW10_MAX 347
+
+// 10^e 的128位尾数（向下截断，最高位为1），{低64位, 高64位}，e = LEPT_POW10_MIN ... LEPT_POW10_MAX
+static const uint64_t lept_pow10_128[][2] = {
+    {0x1732C869CD60E453, 0xFA8FD5A0081C0288}, {0x0E7FBD42205C8EB4, 0x9C99E58405118195},
+    {0x521FAC92A873B261, 0xC3C05EE50655E1FA}, {0xE6A797B752909EF9, 0xF4B0769E47EB5A78},
+    {0x9028BED2939A635C, 0x98EE4A22ECF3188B}, {0x7432EE873880FC33, 0xBF29DCABA82FDEAE},
+    {0x113FAA2906A13B3F, 0xEEF453D6923BD65A}, {0x4AC7CA59A424C507, 0x9558B4661B6565F8},
+    {0x5D79BCF00D2DF649, 0xBAAEE17FA23EBF76}, {0xF4D82C2C107973DC, 0xE95A99DF8ACE6F53},
+    {0x79071B9B8A4BE869, 0x91D8A02BB6C10594}, {0x9748E2826CDEE284, 0xB64EC836A47146F9},
+    {0xFD1B1B2308169B25, 0xE3E27A444D8D98B7}, {0xFE30F0F5E50E20F7, 0x8E6D8C6AB0787F72},
+    {0xBDBD2D335E51A935, 0xB208EF855C969F4F}, {0xAD2C788035E61382, 0xDE8B2B66B3BC4723},
+    {0x4C3BCB5021AFCC31, 0x8B16FB203055AC76}, {0xDF4ABE242A1BBF3D, 0xADDCB9E83C6B1793},
+    {0xD71D6DAD34A2AF0D, 0xD953E8624B85DD78}, {0x8672648C40E5AD68, 0x87D4713D6F33AA6B},
+    {0x680EFDAF511F18C2, 0xA9C98D8CCB009506}, {0x0212BD1B2566DEF2, 0xD43BF0EFFDC0BA48},
+    {0x014BB630F7604B57, 0x84A57695FE98746D}, {0x419EA3BD35385E2D, 0xA5CED43B7E3E9188},
+    {0x52064CAC828675B9, 0xCF42894A5DCE35EA}, {0x7343EFEBD1940993, 0x818995CE7AA0E1B2},
+    {0x1014EBE6C5F90BF8, 0xA1EBFB4219491A1F}, {0xD41A26E077774EF6, 0xCA66FA129F9B60A6},
+    {0x8920B098955522B4, 0xFD00B897478238D0}, {0x55B46E5F5D5535B0, 0x9E20735E8CB16382},
+    {0xEB2189F734AA831D, 0xC5A890362FDDBC62}, {0xA5E9EC7501D523E4, 0xF712B443BBD52B7B},
+    {0x47B233C92125366E, 0x9A6BB0AA55653B2D}, {0x999EC0BB696E840A, 0xC1069CD4EABE89F8},
+    {0xC00670EA43CA250D, 0xF148440A256E2C76}, {0x380406926A5E5728, 0x96CD2A865764DBCA},
+    {0xC605083704F5ECF2, 0xBC807527ED3E12BC}, {0xF7864A44C633682E, 0xEBA09271E88D976B},
+    {0x7AB3EE6AFBE0211D, 0x93445B8731587EA3}, {0x5960EA05BAD82964, 0xB8157268FDAE9E4C},
+    {0x6FB92487298E33BD, 0xE61ACF033D1A45DF}, {0xA5D3B6D479F8E056, 0x8FD0C16206306BAB},
+    {0x8F48A4899877186C, 0xB3C4F1BA87BC8696}, {0x331ACDABFE94DE87, 0xE0B62E2929ABA83C},
+    {0x9FF0C08B7F1D0B14, 0x8C71DCD9BA0B4925}, {0x07ECF0AE5EE44DD9, 0xAF8E5410288E1B6F},
+    {0xC9E82CD9F69D6150, 0xDB71E91432B1A24A}, {0xBE311C083A225CD2, 0x892731AC9FAF056E},
+    {0x6DBD630A48AAF406, 0xAB70FE17C79AC6CA}, {0x092CBBCCDAD5B108, 0xD64D3D9DB981787D},
+    {0x25BBF56008C58EA5, 0x85F0468293F0EB4E}, {0xAF2AF2B80AF6F24E, 0xA76C582338ED2621},
+    {0x1AF5AF660DB4AEE1, 0xD1476E2C07286FAA}, {0x50D98D9FC890ED4D, 0x82CCA4DB847945CA},
+    {0xE50FF107BAB528A0, 0xA37FCE126597973C}, {0x1E53ED49A96272C8, 0xCC5FC196FEFD7D0C},
+    {0x25E8E89C13BB0F7A, 0xFF77B1FCBEBCDC4F}, {0x77B191618C54E9AC, 0x9FAACF3DF73609B1},
+    {0xD59DF5B9EF6A2417, 0xC795830D75038C1D}, {0x4B0573286B44AD1D, 0xF97AE3D0D2446F25},
+    {0x4EE367F9430AEC32, 0x9BECCE62836AC577}, {0x229C41F793CDA73F, 0xC2E801FB244576D5},
+    {0x6B43527578C1110F, 0xF3A20279ED56D48A}, {0x830A13896B78AAA9, 0x9845418C345644D6},
+    {0x23CC986BC656D553, 0xBE5691EF416BD60C}, {0x2CBFBE86B7EC8AA8, 0xEDEC366B11C6CB8F},
+    {0x7BF7D71432F3D6A9, 0x94B3A202EB1C3F39}, {0xDAF5CCD93FB0CC53, 0xB9E08A83A5E34F07},
+    {0xD1B3400F8F9CFF68, 0xE858AD248F5C22C9}, {0x23100809B9C21FA1, 0x91376C36D99995BE},
+    {0xABD40A0C2832A78A, 0xB58547448FFFFB2D}, {0x16C90C8F323F516C, 0xE2E69915B3FFF9F9},
+    {0xAE3DA7D97F6792E3, 0x8DD01FAD907FFC3B}, {0x99CD11CFDF41779C, 0xB1442798F49FFB4A},
+    {0x40405643D711D583, 0xDD95317F31C7FA1D}, {0x482835EA666B2572, 0x8A7D3EEF7F1CFC52},
+    {0xDA3243650005EECF, 0xAD1C8EAB5EE43B66}, {0x90BED43E40076A82, 0xD863B256369D4A40},
+    {0x5A7744A6E804A291, 0x873E4F75E2224E68}, {0x711515D0A205CB36, 0xA90DE3535AAAE202},
+    {0x0D5A5B44CA873E03, 0xD3515C2831559A83}, {0xE858790AFE9486C2, 0x8412D9991ED58091},
+    {0x626E974DBE39A872, 0xA5178FFF668AE0B6}, {0xFB0A3D212DC8128F, 0xCE5D73FF402D98E3},
+    {0x7CE66634BC9D0B99, 0x80FA687F881C7F8E}, {0x1C1FFFC1EBC44E80, 0xA139029F6A239F72},
+    {0xA327FFB266B56220, 0xC987434744AC874E}, {0x4BF1FF9F0062BAA8, 0xFBE9141915D7A922},
+    {0x6F773FC3603DB4A9, 0x9D71AC8FADA6C9B5}, {0xCB550FB4384D21D3, 0xC4CE17B399107C22},
+    {0x7E2A53A146606A48, 0xF6019DA07F549B2B}, {0x2EDA7444CBFC426D, 0x99C102844F94E0FB},
+    {0xFA911155FEFB5308, 0xC0314325637A1939}, {0x793555AB7EBA27CA, 0xF03D93EEBC589F88},
+    {0x4BC1558B2F3458DE, 0x96267C7535B763B5}, {0x9EB1AAEDFB016F16, 0xBBB01B9283253CA2},
+    {0x465E15A979C1CADC, 0xEA9C227723EE8BCB}, {0x0BFACD89EC191EC9, 0x92A1958A7675175F},
+    {0xCEF980EC671F667B, 0xB749FAED14125D36}, {0x82B7E12780E7401A, 0xE51C79A85916F484},
+    {0xD1B2ECB8B0908810, 0x8F31CC0937AE58D2}, {0x861FA7E6DCB4AA15, 0xB2FE3F0B8599EF07},
+    {0x67A791E093E1D49A, 0xDFBDCECE67006AC9}, {0xE0C8BB2C5C6D24E0, 0x8BD6A141006042BD},
+    {0x58FAE9F773886E18, 0xAECC49914078536D}, {0xAF39A475506A899E, 0xDA7F5BF590966848},
+    {0x6D8406C952429603, 0x888F99797A5E012D}, {0xC8E5087BA6D33B83, 0xAAB37FD7D8F58178},
+    {0xFB1E4A9A90880A64, 0xD5605FCDCF32E1D6}, {0x5CF2EEA09A55067F, 0x855C3BE0A17FCD26},
+    {0xF42FAA48C0EA481E, 0xA6B34AD8C9DFC06F}, {0xF13B94DAF124DA26, 0xD0601D8EFC57B08B},
+    {0x76C53D08D6B70858, 0x823C12795DB6CE57}, {0x54768C4B0C64CA6E, 0xA2CB1717B52481ED},
+    {0xA9942F5DCF7DFD09, 0xCB7DDCDDA26DA268}, {0xD3F93B35435D7C4C, 0xFE5D54150B090B02},
+    {0xC47BC5014A1A6DAF, 0x9EFA548D26E5A6E1}, {0x359AB6419CA1091B, 0xC6B8E9B0709F109A},
+    {0xC30163D203C94B62, 0xF867241C8CC6D4C0}, {0x79E0DE63425DCF1D, 0x9B407691D7FC44F8},
+    {0x985915FC12F542E4, 0xC21094364DFB5636}, {0x3E6F5B7B17B2939D, 0xF294B943E17A2BC4},
+    {0xA705992CEECF9C42, 0x979CF3CA6CEC5B5A}, {0x50C6FF782A838353, 0xBD8430BD08277231},
+    {0xA4F8BF5635246428, 0xECE53CEC4A314EBD}, {0x871B7795E136BE99, 0x940F4613AE5ED136},
+    {0x28E2557B59846E3F, 0xB913179899F68584}, {0x331AEADA2FE589CF, 0xE757DD7EC07426E5},
+    {0x3FF0D2C85DEF7621, 0x9096EA6F3848984F}, {0x0FED077A756B53A9, 0xB4BCA50B065ABE63},
+    {0xD3E8495912C62894, 0xE1EBCE4DC7F16DFB}, {0x64712DD7ABBBD95C, 0x8D3360F09CF6E4BD},
+    {0xBD8D794D96AACFB3, 0xB080392CC4349DEC}, {0xECF0D7A0FC5583A0, 0xDCA04777F541C567},
+    {0xF41686C49DB57244, 0x89E42CAAF9491B60}, {0x311C2875C522CED5, 0xAC5D37D5B79B6239},
+    {0x7D633293366B828B, 0xD77485CB25823AC7}, {0xAE5DFF9C02033197, 0x86A8D39EF77164BC},
+    {0xD9F57F830283FDFC, 0xA8530886B54DBDEB}, {0xD072DF63C324FD7B, 0xD267CAA862A12D66},
+    {0x4247CB9E59F71E6D, 0x8380DEA93DA4BC60}, {0x52D9BE85F074E608, 0xA46116538D0DEB78},
+    {0x67902E276C921F8B, 0xCD795BE870516656}, {0x00BA1CD8A3DB53B6, 0x806BD9714632DFF6},
+    {0x80E8A40ECCD228A4, 0xA086CFCD97BF97F3}, {0x6122CD128006B2CD, 0xC8A883C0FDAF7DF0},
+    {0x796B805720085F81, 0xFAD2A4B13D1B5D6C}, {0xCBE3303674053BB0, 0x9CC3A6EEC6311A63},
+    {0xBEDBFC4411068A9C, 0xC3F490AA77BD60FC}, {0xEE92FB5515482D44, 0xF4F1B4D515ACB93B},
+    {0x751BDD152D4D1C4A, 0x991711052D8BF3C5}, {0xD262D45A78A0635D, 0xBF5CD54678EEF0B6},
+    {0x86FB897116C87C34, 0xEF340A98172AACE4}, {0xD45D35E6AE3D4DA0, 0x9580869F0E7AAC0E},
+    {0x8974836059CCA109, 0xBAE0A846D2195712}, {0x2BD1A438703FC94B, 0xE998D258869FACD7},
+    {0x7B6306A34627DDCF, 0x91FF83775423CC06}, {0x1A3BC84C17B1D542, 0xB67F6455292CBF08},
+    {0x20CABA5F1D9E4A93, 0xE41F3D6A7377EECA}, {0x547EB47B7282EE9C, 0x8E938662882AF53E},
+    {0xE99E619A4F23AA43, 0xB23867FB2A35B28D}, {0x6405FA00E2EC94D4, 0xDEC681F9F4C31F31},
+    {0xDE83BC408DD3DD04, 0x8B3C113C38F9F37E}, {0x9624AB50B148D445, 0xAE0B158B4738705E},
+    {0x3BADD624DD9B0957, 0xD98DDAEE19068C76}, {0xE54CA5D70A80E5D6, 0x87F8A8D4CFA417C9},
+    {0x5E9FCF4CCD211F4C, 0xA9F6D30A038D1DBC}, {0x7647C3200069671F, 0xD47487CC8470652B},
+    {0x29ECD9F40041E073, 0x84C8D4DFD2C63F3B}, {0xF468107100525890, 0xA5FB0A17C777CF09},
+    {0x7182148D4066EEB4, 0xCF79CC9DB955C2CC}, {0xC6F14CD848405530, 0x81AC1FE293D599BF},
+    {0xB8ADA00E5A506A7C, 0xA21727DB38CB002F}, {0xA6D90811F0E4851C, 0xCA9CF1D206FDC03B},
+    {0x908F4A166D1DA663, 0xFD442E4688BD304A}, {0x9A598E4E043287FE, 0x9E4A9CEC15763E2E},
+    {0x40EFF1E1853F29FD, 0xC5DD44271AD3CDBA}, {0xD12BEE59E68EF47C, 0xF7549530E188C128},
+    {0x82BB74F8301958CE, 0x9A94DD3E8CF578B9}, {0xE36A52363C1FAF01, 0xC13A148E3032D6E7},
+    {0xDC44E6C3CB279AC1, 0xF18899B1BC3F8CA1}, {0x29AB103A5EF8C0B9, 0x96F5600F15A7B7E5},
+    {0x7415D448F6B6F0E7, 0xBCB2B812DB11A5DE}, {0x111B495B3464AD21, 0xEBDF661791D60F56},
+    {0xCAB10DD900BEEC34, 0x936B9FCEBB25C995}, {0x3D5D514F40EEA742, 0xB84687C269EF3BFB},
+    {0x0CB4A5A3112A5112, 0xE65829B3046B0AFA}, {0x47F0E785EABA72AB, 0x8FF71A0FE2C2E6DC},
+    {0x59ED216765690F56, 0xB3F4E093DB73A093}, {0x306869C13EC3532C, 0xE0F218B8D25088B8},
+    {0x1E414218C73A13FB, 0x8C974F7383725573}, {0xE5D1929EF90898FA, 0xAFBD2350644EEACF},
+    {0xDF45F746B74ABF39, 0xDBAC6C247D62A583}, {0x6B8BBA8C328EB783, 0x894BC396CE5DA772},
+    {0x066EA92F3F326564, 0xAB9EB47C81F5114F}, {0xC80A537B0EFEFEBD, 0xD686619BA27255A2},
+    {0xBD06742CE95F5F36, 0x8613FD0145877585}, {0x2C48113823B73704, 0xA798FC4196E952E7},
+    {0xF75A15862CA504C5, 0xD17F3B51FCA3A7A0}, {0x9A984D73DBE722FB, 0x82EF85133DE648C4},
+    {0xC13E60D0D2E0EBBA, 0xA3AB66580D5FDAF5}, {0x318DF905079926A8, 0xCC963FEE10B7D1B3},
+    {0xFDF17746497F7052, 0xFFBBCFE994E5C61F}, {0xFEB6EA8BEDEFA633, 0x9FD561F1FD0F9BD3},
+    {0xFE64A52EE96B8FC0, 0xC7CABA6E7C5382C8}, {0x3DFDCE7AA3C673B0, 0xF9BD690A1B68637B},
+    {0x06BEA10CA65C084E, 0x9C1661A651213E2D}, {0x486E494FCFF30A62, 0xC31BFA0FE5698DB8},
+    {0x5A89DBA3C3EFCCFA, 0xF3E2F893DEC3F126}, {0xF89629465A75E01C, 0x986DDB5C6B3A76B7},
+    {0xF6BBB397F1135823, 0xBE89523386091465}, {0x746AA07DED582E2C, 0xEE2BA6C0678B597F},
+    {0xA8C2A44EB4571CDC, 0x94DB483840B717EF}, {0x92F34D62616CE413, 0xBA121A4650E4DDEB},
+    {0x77B020BAF9C81D17, 0xE896A0D7E51E1566}, {0x0ACE1474DC1D122E, 0x915E2486EF32CD60},
+    {0x0D819992132456BA, 0xB5B5ADA8AAFF80B8}, {0x10E1FFF697ED6C69, 0xE3231912D5BF60E6},
+    {0xCA8D3FFA1EF463C1, 0x8DF5EFABC5979C8F}, {0xBD308FF8A6B17CB2, 0xB1736B96B6FD83B3},
+    {0xAC7CB3F6D05DDBDE, 0xDDD0467C64BCE4A0}, {0x6BCDF07A423AA96B, 0x8AA22C0DBEF60EE4},
+    {0x86C16C98D2C953C6, 0xAD4AB7112EB3929D}, {0xE871C7BF077BA8B7, 0xD89D64D57A607744},
+    {0x11471CD764AD4972, 0x87625F056C7C4A8B}, {0xD598E40D3DD89BCF, 0xA93AF6C6C79B5D2D},
+    {0x4AFF1D108D4EC2C3, 0xD389B47879823479}, {0xCEDF722A585139BA, 0x843610CB4BF160CB},
+    {0xC2974EB4EE658828, 0xA54394FE1EEDB8FE}, {0x733D226229FEEA32, 0xCE947A3DA6A9273E},
+    {0x0806357D5A3F525F, 0x811CCC668829B887}, {0xCA07C2DCB0CF26F7, 0xA163FF802A3426A8},
+    {0xFC89B393DD02F0B5, 0xC9BCFF6034C13052}, {0xBBAC2078D443ACE2, 0xFC2C3F3841F17C67},
+    {0xD54B944B84AA4C0D, 0x9D9BA7832936EDC0}, {0x0A9E795E65D4DF11, 0xC5029163F384A931},
+    {0x4D4617B5FF4A16D5, 0xF64335BCF065D37D}, {0x504BCED1BF8E4E45, 0x99EA0196163FA42E},
+    {0xE45EC2862F71E1D6, 0xC06481FB9BCF8D39}, {0x5D767327BB4E5A4C, 0xF07DA27A82C37088},
+    {0x3A6A07F8D510F86F, 0x964E858C91BA2655}, {0x890489F70A55368B, 0xBBE226EFB628AFEA},
+    {0x2B45AC74CCEA842E, 0xEADAB0ABA3B2DBE5}, {0x3B0B8BC90012929D, 0x92C8AE6B464FC96F},
+    {0x09CE6EBB40173744, 0xB77ADA0617E3BBCB}, {0xCC420A6A101D0515, 0xE55990879DDCAABD},
+    {0x9FA946824A12232D, 0x8F57FA54C2A9EAB6}, {0x47939822DC96ABF9, 0xB32DF8E9F3546564},
+    {0x59787E2B93BC56F7, 0xDFF9772470297EBD}, {0x57EB4EDB3C55B65A, 0x8BFBEA76C619EF36},
+    {0xEDE622920B6B23F1, 0xAEFAE51477A06B03}, {0xE95FAB368E45ECED, 0xDAB99E59958885C4},
+    {0x11DBCB0218EBB414, 0x88B402F7FD75539B}, {0xD652BDC29F26A119, 0xAAE103B5FCD2A881},
+    {0x4BE76D3346F0495F, 0xD59944A37C0752A2}, {0x6F70A4400C562DDB, 0x857FCAE62D8493A5},
+    {0xCB4CCD500F6BB952, 0xA6DFBD9FB8E5B88E}, {0x7E2000A41346A7A7, 0xD097AD07A71F26B2},
+    {0x8ED400668C0C28C8, 0x825ECC24C873782F}, {0x728900802F0F32FA, 0xA2F67F2DFA90563B},
+    {0x4F2B40A03AD2FFB9, 0xCBB41EF979346BCA}, {0xE2F610C84987BFA8, 0xFEA126B7D78186BC},
+    {0x0DD9CA7D2DF4D7C9, 0x9F24B832E6B0F436}, {0x91503D1C79720DBB, 0xC6EDE63FA05D3143},
+    {0x75A44C6397CE912A, 0xF8A95FCF88747D94}, {0xC986AFBE3EE11ABA, 0x9B69DBE1B548CE7C},
+    {0xFBE85BADCE996168, 0xC24452DA229B021B}, {0xFAE27299423FB9C3, 0xF2D56790AB41C2A2},
+    {0xDCCD879FC967D41A, 0x97C560BA6B0919A5}, {0x5400E987BBC1C920, 0xBDB6B8E905CB600F},
+    {0x290123E9AAB23B68, 0xED246723473E3813}, {0xF9A0B6720AAF6521, 0x9436C0760C86E30B},
+    {0xF808E40E8D5B3E69, 0xB94470938FA89BCE}, {0xB60B1D1230B20E04, 0xE7958CB87392C2C2},
+    {0xB1C6F22B5E6F48C2, 0x90BD77F3483BB9B9}, {0x1E38AEB6360B1AF3, 0xB4ECD5F01A4AA828},
+    {0x25C6DA63C38DE1B0, 0xE2280B6C20DD5232}, {0x579C487E5A38AD0E, 0x8D590723948A535F},
+    {0x2D835A9DF0C6D851, 0xB0AF48EC79ACE837}, {0xF8E431456CF88E65, 0xDCDB1B2798182244},
+    {0x1B8E9ECB641B58FF, 0x8A08F0F8BF0F156B}, {0xE272467E3D222F3F, 0xAC8B2D36EED2DAC5},
+    {0x5B0ED81DCC6ABB0F, 0xD7ADF884AA879177}, {0x98E947129FC2B4E9, 0x86CCBB52EA94BAEA},
+    {0x3F2398D747B36224, 0xA87FEA27A539E9A5}, {0x8EEC7F0D19A03AAD, 0xD29FE4B18E88640E},
+    {0x1953CF68300424AC, 0x83A3EEEEF9153E89}, {0x5FA8C3423C052DD7, 0xA48CEAAAB75A8E2B},
+    {0x3792F412CB06794D, 0xCDB02555653131B6}, {0xE2BBD88BBEE40BD0, 0x808E17555F3EBF11},
+    {0x5B6ACEAEAE9D0EC4, 0xA0B19D2AB70E6ED6}, {0xF245825A5A445275, 0xC8DE047564D20A8B},
+    {0xEED6E2F0F0D56712, 0xFB158592BE068D2E}, {0x55464DD69685606B, 0x9CED737BB6C4183D},
+    {0xAA97E14C3C26B886, 0xC428D05AA4751E4C}, {0xD53DD99F4B3066A8, 0xF53304714D9265DF},
+    {0xE546A8038EFE4029, 0x993FE2C6D07B7FAB}, {0xDE98520472BDD033, 0xBF8FDB78849A5F96},
+    {0x963E66858F6D4440, 0xEF73D256A5C0F77C}, {0xDDE7001379A44AA8, 0x95A8637627989AAD},
+    {0x5560C018580D5D52, 0xBB127C53B17EC159}, {0xAAB8F01E6E10B4A6, 0xE9D71B689DDE71AF},
+    {0xCAB3961304CA70E8, 0x9226712162AB070D}, {0x3D607B97C5FD0D22, 0xB6B00D69BB55C8D1},
+    {0x8CB89A7DB77C506A, 0xE45C10C42A2B3B05}, {0x77F3608E92ADB242, 0x8EB98A7A9A5B04E3},
+    {0x55F038B237591ED3, 0xB267ED1940F1C61C}, {0x6B6C46DEC52F6688, 0xDF01E85F912E37A3},
+    {0x2323AC4B3B3DA015, 0x8B61313BBABCE2C6}, {0xABEC975E0A0D081A, 0xAE397D8AA96C1B77},
+    {0x96E7BD358C904A21, 0xD9C7DCED53C72255}, {0x7E50D64177DA2E54, 0x881CEA14545C7575},
+    {0xDDE50BD1D5D0B9E9, 0xAA242499697392D2}, {0x955E4EC64B44E864, 0xD4AD2DBFC3D07787},
+    {0xBD5AF13BEF0B113E, 0x84EC3C97DA624AB4}, {0xECB1AD8AEACDD58E, 0xA6274BBDD0FADD61},
+    {0x67DE18EDA5814AF2, 0xCFB11EAD453994BA}, {0x80EACF948770CED7, 0x81CEB32C4B43FCF4},
+    {0xA1258379A94D028D, 0xA2425FF75E14FC31}, {0x096EE45813A04330, 0xCAD2F7F5359A3B3E},
+    {0x8BCA9D6E188853FC, 0xFD87B5F28300CA0D}, {0x775EA264CF55347D, 0x9E74D1B791E07E48},
+    {0x95364AFE032A819D, 0xC612062576589DDA}, {0x3A83DDBD83F52204, 0xF79687AED3EEC551},
+    {0xC4926A9672793542, 0x9ABE14CD44753B52}, {0x75B7053C0F178293, 0xC16D9A0095928A27},
+    {0x5324C68B12DD6338, 0xF1C90080BAF72CB1}, {0xD3F6FC16EBCA5E03, 0x971DA05074DA7BEE},
+    {0x88F4BB1CA6BCF584, 0xBCE5086492111AEA}, {0x2B31E9E3D06C32E5, 0xEC1E4A7DB69561A5},
+    {0x3AFF322E62439FCF, 0x9392EE8E921D5D07}, {0x09BEFEB9FAD487C2, 0xB877AA3236A4B449},
+    {0x4C2EBE687989A9B3, 0xE69594BEC44DE15B}, {0x0F9D37014BF60A10, 0x901D7CF73AB0ACD9},
+    {0x538484C19EF38C94, 0xB424DC35095CD80F}, {0x2865A5F206B06FB9, 0xE12E13424BB40E13},
+    {0xF93F87B7442E45D3, 0x8CBCCC096F5088CB}, {0xF78F69A51539D748, 0xAFEBFF0BCB24AAFE},
+    {0xB573440E5A884D1B, 0xDBE6FECEBDEDD5BE}, {0x31680A88F8953030, 0x89705F4136B4A597},
+    {0xFDC20D2B36BA7C3D, 0xABCC77118461CEFC}, {0x3D32907604691B4C, 0xD6BF94D5E57A42BC},
+    {0xA63F9A49C2C1B10F, 0x8637BD05AF6C69B5}, {0x0FCF80DC33721D53, 0xA7C5AC471B478423},
+    {0xD3C36113404EA4A8, 0xD1B71758E219652B}, {0x645A1CAC083126E9, 0x83126E978D4FDF3B},
+    {0x3D70A3D70A3D70A3, 0xA3D70A3D70A3D70A}, {0xCCCCCCCCCCCCCCCC, 0xCCCCCCCCCCCCCCCC},
+    {0x0000000000000000, 0x8000000000000000}, {0x0000000000000000, 0xA000000000000000},
+    {0x0000000000000000, 0xC800000000000000}, {0x0000000000000000, 0xFA00000000000000},
+    {0x0000000000000000, 0x9C40000000000000}, {0x0000000000000000, 0xC350000000000000},
+    {0x0000000000000000, 0xF424000000000000}, {0x0000000000000000, 0x9896800000000000},
+    {0x0000000000000000, 0xBEBC200000000000}, {0x0000000000000000, 0xEE6B280000000000},
+    {0x0000000000000000, 0x9502F90000000000}, {0x0000000000000000, 0xBA43B74000000000},
+    {0x0000000000000000, 0xE8D4A51000000000}, {0x0000000000000000, 0x9184E72A00000000},
+    {0x0000000000000000, 0xB5E620F480000000}, {0x0000000000000000, 0xE35FA931A0000000},
+    {0x0000000000000000, 0x8E1BC9BF04000000}, {0x0000000000000000, 0xB1A2BC2EC5000000},
+    {0x0000000000000000, 0xDE0B6B3A76400000}, {0x0000000000000000, 0x8AC7230489E80000},
+    {0x0000000000000000, 0xAD78EBC5AC620000}, {0x0000000000000000, 0xD8D726B7177A8000},
+    {0x0000000000000000, 0x878678326EAC9000}, {0x0000000000000000, 0xA968163F0A57B400},
+    {0x0000000000000000, 0xD3C21BCECCEDA100}, {0x0000000000000000, 0x84595161401484A0},
+    {0x0000000000000000, 0xA56FA5B99019A5C8}, {0x0000000000000000, 0xCECB8F27F4200F3A},
+    {0x4000000000000000, 0x813F3978F8940984}, {0x5000000000000000, 0xA18F07D736B90BE5},
+    {0xA400000000000000, 0xC9F2C9CD04674EDE}, {0x4D00000000000000, 0xFC6F7C4045812296},
+    {0xF020000000000000, 0x9DC5ADA82B70B59D}, {0x6C28000000000000, 0xC5371912364CE305},
+    {0xC732000000000000, 0xF684DF56C3E01BC6}, {0x3C7F400000000000, 0x9A130B963A6C115C},
+    {0x4B9F100000000000, 0xC097CE7BC90715B3}, {0x1E86D40000000000, 0xF0BDC21ABB48DB20},
+    {0x1314448000000000, 0x96769950B50D88F4}, {0x17D955A000000000, 0xBC143FA4E250EB31},
+    {0x5DCFAB0800000000, 0xEB194F8E1AE525FD}, {0x5AA1CAE500000000, 0x92EFD1B8D0CF37BE},
+    {0xF14A3D9E40000000, 0xB7ABC627050305AD}, {0x6D9CCD05D0000000, 0xE596B7B0C643C719},
+    {0xE4820023A2000000, 0x8F7E32CE7BEA5C6F}, {0xDDA2802C8A800000, 0xB35DBF821AE4F38B},
+    {0xD50B2037AD200000, 0xE0352F62A19E306E}, {0x4526F422CC340000, 0x8C213D9DA502DE45},
+    {0x9670B12B7F410000, 0xAF298D050E4395D6}, {0x3C0CDD765F114000, 0xDAF3F04651D47B4C},
+    {0xA5880A69FB6AC800, 0x88D8762BF324CD0F}, {0x8EEA0D047A457A00, 0xAB0E93B6EFEE0053},
+    {0x72A4904598D6D880, 0xD5D238A4ABE98068}, {0x47A6DA2B7F864750, 0x85A36366EB71F041},
+    {0x999090B65F67D924, 0xA70C3C40A64E6C51}, {0xFFF4B4E3F741CF6D, 0xD0CF4B50CFE20765},
+    {0xBFF8F10E7A8921A4, 0x82818F1281ED449F}, {0xAFF72D52192B6A0D, 0xA321F2D7226895C7},
+    {0x9BF4F8A69F764490, 0xCBEA6F8CEB02BB39}, {0x02F236D04753D5B4, 0xFEE50B7025C36A08},
+    {0x01D762422C946590, 0x9F4F2726179A2245}, {0x424D3AD2B7B97EF5, 0xC722F0EF9D80AAD6},
+    {0xD2E0898765A7DEB2, 0xF8EBAD2B84E0D58B}, {0x63CC55F49F88EB2F, 0x9B934C3B330C8577},
+    {0x3CBF6B71C76B25FB, 0xC2781F49FFCFA6D5}, {0x8BEF464E3945EF7A, 0xF316271C7FC3908A},
+    {0x97758BF0E3CBB5AC, 0x97EDD871CFDA3A56}, {0x3D52EEED1CBEA317, 0xBDE94E8E43D0C8EC},
+    {0x4CA7AAA863EE4BDD, 0xED63A231D4C4FB27}, {0x8FE8CAA93E74EF6A, 0x945E455F24FB1CF8},
+    {0xB3E2FD538E122B44, 0xB975D6B6EE39E436}, {0x60DBBCA87196B616, 0xE7D34C64A9C85D44},
+    {0xBC8955E946FE31CD, 0x90E40FBEEA1D3A4A}, {0x6BABAB6398BDBE41, 0xB51D13AEA4A488DD},
+    {0xC696963C7EED2DD1, 0xE264589A4DCDAB14}, {0xFC1E1DE5CF543CA2, 0x8D7EB76070A08AEC},
+    {0x3B25A55F43294BCB, 0xB0DE65388CC8ADA8}, {0x49EF0EB713F39EBE, 0xDD15FE86AFFAD912},
+    {0x6E3569326C784337, 0x8A2DBF142DFCC7AB}, {0x49C2C37F07965404, 0xACB92ED9397BF996},
+    {0xDC33745EC97BE906, 0xD7E77A8F87DAF7FB}, {0x69A028BB3DED71A3, 0x86F0AC99B4E8DAFD},
+    {0xC40832EA0D68CE0C, 0xA8ACD7C0222311BC}, {0xF50A3FA490C30190, 0xD2D80DB02AABD62B},
+    {0x792667C6DA79E0FA, 0x83C7088E1AAB65DB}, {0x577001B891185938, 0xA4B8CAB1A1563F52},
+    {0xED4C0226B55E6F86, 0xCDE6FD5E09ABCF26}, {0x544F8158315B05B4, 0x80B05E5AC60B6178},
+    {0x696361AE3DB1C721, 0xA0DC75F1778E39D6}, {0x03BC3A19CD1E38E9, 0xC913936DD571C84C},
+    {0x04AB48A04065C723, 0xFB5878494ACE3A5F}, {0x62EB0D64283F9C76, 0x9D174B2DCEC0E47B},
+    {0x3BA5D0BD324F8394, 0xC45D1DF942711D9A}, {0xCA8F44EC7EE36479, 0xF5746577930D6500},
+    {0x7E998B13CF4E1ECB, 0x9968BF6ABBE85F20}, {0x9E3FEDD8C321A67E, 0xBFC2EF456AE276E8},
+    {0xC5CFE94EF3EA101E, 0xEFB3AB16C59B14A2}, {0xBBA1F1D158724A12, 0x95D04AEE3B80ECE5},
+    {0x2A8A6E45AE8EDC97, 0xBB445DA9CA61281F}, {0xF52D09D71A3293BD, 0xEA1575143CF97226},
+    {0x593C2626705F9C56, 0x924D692CA61BE758}, {0x6F8B2FB00C77836C, 0xB6E0C377CFA2E12E},
+    {0x0B6DFB9C0F956447, 0xE498F455C38B997A}, {0x4724BD4189BD5EAC, 0x8EDF98B59A373FEC},
+    {0x58EDEC91EC2CB657, 0xB2977EE300C50FE7}, {0x2F2967B66737E3ED, 0xDF3D5E9BC0F653E1},
+    {0xBD79E0D20082EE74, 0x8B865B215899F46C}, {0xECD8590680A3AA11, 0xAE67F1E9AEC07187},
+    {0xE80E6F4820CC9495, 0xDA01EE641A708DE9}, {0x3109058D147FDCDD, 0x884134FE908658B2},
+    {0xBD4B46F0599FD415, 0xAA51823E34A7EEDE}, {0x6C9E18AC7007C91A, 0xD4E5E2CDC1D1EA96},
+    {0x03E2CF6BC604DDB0, 0x850FADC09923329E}, {0x84DB8346B786151C, 0xA6539930BF6BFF45},
+    {0xE612641865679A63, 0xCFE87F7CEF46FF16}, {0x4FCB7E8F3F60C07E, 0x81F14FAE158C5F6E},
+    {0xE3BE5E330F38F09D, 0xA26DA3999AEF7749}, {0x5CADF5BFD3072CC5, 0xCB090C8001AB551C},
+    {0x73D9732FC7C8F7F6, 0xFDCB4FA002162A63}, {0x2867E7FDDCDD9AFA, 0x9E9F11C4014DDA7E},
+    {0xB281E1FD541501B8, 0xC646D63501A1511D}, {0x1F225A7CA91A4226, 0xF7D88BC24209A565},
+    {0x3375788DE9B06958, 0x9AE757596946075F}, {0x0052D6B1641C83AE, 0xC1A12D2FC3978937},
+    {0xC0678C5DBD23A49A, 0xF209787BB47D6B84}, {0xF840B7BA963646E0, 0x9745EB4D50CE6332},
+    {0xB650E5A93BC3D898, 0xBD176620A501FBFF}, {0xA3E51F138AB4CEBE, 0xEC5D3FA8CE427AFF},
+    {0xC66F336C36B10137, 0x93BA47C980E98CDF}, {0xB80B0047445D4184, 0xB8A8D9BBE123F017},
+    {0xA60DC059157491E5, 0xE6D3102AD96CEC1D}, {0x87C89837AD68DB2F, 0x9043EA1AC7E41392},
+    {0x29BABE4598C311FB, 0xB454E4A179DD1877}, {0xF4296DD6FEF3D67A, 0xE16A1DC9D8545E94},
+    {0x1899E4A65F58660C, 0x8CE2529E2734BB1D}, {0x5EC05DCFF72E7F8F, 0xB01AE745B101E9E4},
+    {0x76707543F4FA1F73, 0xDC21A1171D42645D}, {0x6A06494A791C53A8, 0x899504AE72497EBA},
+    {0x0487DB9D17636892, 0xABFA45DA0EDBDE69}, {0x45A9D2845D3C42B6, 0xD6F8D7509292D603},
+    {0x0B8A2392BA45A9B2, 0x865B86925B9BC5C2}, {0x8E6CAC7768D7141E, 0xA7F26836F282B732},
+    {0x3207D795430CD926, 0xD1EF0244AF2364FF}, {0x7F44E6BD49E807B8, 0x8335616AED761F1F},
+    {0x5F16206C9C6209A6, 0xA402B9C5A8D3A6E7}, {0x36DBA887C37A8C0F, 0xCD036837130890A1},
+    {0xC2494954DA2C9789, 0x802221226BE55A64}, {0xF2DB9BAA10B7BD6C, 0xA02AA96B06DEB0FD},
+    {0x6F92829494E5ACC7, 0xC83553C5C8965D3D}, {0xCB772339BA1F17F9, 0xFA42A8B73ABBF48C},
+    {0xFF2A760414536EFB, 0x9C69A97284B578D7}, {0xFEF5138519684ABA, 0xC38413CF25E2D70D},
+    {0x7EB258665FC25D69, 0xF46518C2EF5B8CD1}, {0xEF2F773FFBD97A61, 0x98BF2F79D5993802},
+    {0xAAFB550FFACFD8FA, 0xBEEEFB584AFF8603}, {0x95BA2A53F983CF38, 0xEEAABA2E5DBF6784},
+    {0xDD945A747BF26183, 0x952AB45CFA97A0B2}, {0x94F971119AEEF9E4, 0xBA756174393D88DF},
+    {0x7A37CD5601AAB85D, 0xE912B9D1478CEB17}, {0xAC62E055C10AB33A, 0x91ABB422CCB812EE},
+    {0x577B986B314D6009, 0xB616A12B7FE617AA}, {0xED5A7E85FDA0B80B, 0xE39C49765FDF9D94},
+    {0x14588F13BE847307, 0x8E41ADE9FBEBC27D}, {0x596EB2D8AE258FC8, 0xB1D219647AE6B31C},
+    {0x6FCA5F8ED9AEF3BB, 0xDE469FBD99A05FE3}, {0x25DE7BB9480D5854, 0x8AEC23D680043BEE},
+    {0xAF561AA79A10AE6A, 0xADA72CCC20054AE9}, {0x1B2BA1518094DA04, 0xD910F7FF28069DA4},
+    {0x90FB44D2F05D0842, 0x87AA9AFF79042286}, {0x353A1607AC744A53, 0xA99541BF57452B28},
+    {0x42889B8997915CE8, 0xD3FA922F2D1675F2}, {0x69956135FEBADA11, 0x847C9B5D7C2E09B7},
+    {0x43FAB9837E699095, 0xA59BC234DB398C25}, {0x94F967E45E03F4BB, 0xCF02B2C21207EF2E},
+    {0x1D1BE0EEBAC278F5, 0x8161AFB94B44F57D}, {0x6462D92A69731732, 0xA1BA1BA79E1632DC},
+    {0x7D7B8F7503CFDCFE, 0xCA28A291859BBF93}, {0x5CDA735244C3D43E, 0xFCB2CB35E702AF78},
+    {0x3A0888136AFA64A7, 0x9DEFBF01B061ADAB}, {0x088AAA1845B8FDD0, 0xC56BAEC21C7A1916},
+    {0x8AAD549E57273D45, 0xF6C69A72A3989F5B}, {0x36AC54E2F678864B, 0x9A3C2087A63F6399},
+    {0x84576A1BB416A7DD, 0xC0CB28A98FCF3C7F}, {0x656D44A2A11C51D5, 0xF0FDF2D3F3C30B9F},
+    {0x9F644AE5A4B1B325, 0x969EB7C47859E743}, {0x873D5D9F0DDE1FEE, 0xBC4665B596706114},
+    {0xA90CB506D155A7EA, 0xEB57FF22FC0C7959}, {0x09A7F12442D588F2, 0x9316FF75DD87CBD8},
+    {0x0C11ED6D538AEB2F, 0xB7DCBF5354E9BECE}, {0x8F1668C8A86DA5FA, 0xE5D3EF282A242E81},
+    {0xF96E017D694487BC, 0x8FA475791A569D10}, {0x37C981DCC395A9AC, 0xB38D92D760EC4455},
+    {0x85BBE253F47B1417, 0xE070F78D3927556A}, {0x93956D7478CCEC8E, 0x8C469AB843B89562},
+    {0x387AC8D1970027B2, 0xAF58416654A6BABB}, {0x06997B05FCC0319E, 0xDB2E51BFE9D0696A},
+    {0x441FECE3BDF81F03, 0x88FCF317F22241E2}, {0xD527E81CAD7626C3, 0xAB3C2FDDEEAAD25A},
+    {0x8A71E223D8D3B074, 0xD60B3BD56A5586F1}, {0xF6872D5667844E49, 0x85C7056562757456},
+    {0xB428F8AC016561DB, 0xA738C6BEBB12D16C}, {0xE13336D701BEBA52, 0xD106F86E69D785C7},
+    {0xECC0024661173473, 0x82A45B450226B39C}, {0x27F002D7F95D0190, 0xA34D721642B06084},
+    {0x31EC038DF7B441F4, 0xCC20CE9BD35C78A5}, {0x7E67047175A15271, 0xFF290242C83396CE},
+    {0x0F0062C6E984D386, 0x9F79A169BD203E41}, {0x52C07B78A3E60868, 0xC75809C42C684DD1},
+    {0xA7709A56CCDF8A82, 0xF92E0C3537826145}, {0x88A66076400BB691, 0x9BBCC7A142B17CCB},
+    {0x6ACFF893D00EA435, 0xC2ABF989935DDBFE}, {0x0583F6B8C4124D43, 0xF356F7EBF83552FE},
+    {0xC3727A337A8B704A, 0x98165AF37B2153DE}, {0x744F18C0592E4C5C, 0xBE1BF1B059E9A8D6},
+    {0x1162DEF06F79DF73, 0xEDA2EE1C7064130C}, {0x8ADDCB5645AC2BA8, 0x9485D4D1C63E8BE7},
+    {0x6D953E2BD7173692, 0xB9A74A0637CE2EE1}, {0xC8FA8DB6CCDD0437, 0xE8111C87C5C1BA99},
+    {0x1D9C9892400A22A2, 0x910AB1D4DB9914A0}, {0x2503BEB6D00CAB4B, 0xB54D5E4A127F59C8},
+    {0x2E44AE64840FD61D, 0xE2A0B5DC971F303A}, {0x5CEAECFED289E5D2, 0x8DA471A9DE737E24},
+    {0x7425A83E872C5F47, 0xB10D8E1456105DAD}, {0xD12F124E28F77719, 0xDD50F1996B947518},
+    {0x82BD6B70D99AAA6F, 0x8A5296FFE33CC92F}, {0x636CC64D1001550B, 0xACE73CBFDC0BFB7B},
+    {0x3C47F7E05401AA4E, 0xD8210BEFD30EFA5A}, {0x65ACFAEC34810A71, 0x8714A775E3E95C78},
+    {0x7F1839A741A14D0D, 0xA8D9D1535CE3B396}, {0x1EDE48111209A050, 0xD31045A8341CA07C},
+    {0x934AED0AAB460432, 0x83EA2B892091E44D}, {0xF81DA84D5617853F, 0xA4E4B66B68B65D60},
+    {0x36251260AB9D668E, 0xCE1DE40642E3F4B9}, {0xC1D72B7C6B426019, 0x80D2AE83E9CE78F3},
+    {0xB24CF65B8612F81F, 0xA1075A24E4421730}, {0xDEE033F26797B627, 0xC94930AE1D529CFC},
+    {0x169840EF017DA3B1, 0xFB9B7CD9A4A7443C}, {0x8E1F289560EE864E, 0x9D412E0806E88AA5},
+    {0xF1A6F2BAB92A27E2, 0xC491798A08A2AD4E}, {0xAE10AF696774B1DB, 0xF5B5D7EC8ACB58A2},
+    {0xACCA6DA1E0A8EF29, 0x9991A6F3D6BF1765}, {0x17FD090A58D32AF3, 0xBFF610B0CC6EDD3F},
+    {0xDDFC4B4CEF07F5B0, 0xEFF394DCFF8A948E}, {0x4ABDAF101564F98E, 0x95F83D0A1FB69CD9},
+    {0x9D6D1AD41ABE37F1, 0xBB764C4CA7A4440F}, {0x84C86189216DC5ED, 0xEA53DF5FD18D5513},
+    {0x32FD3CF5B4E49BB4, 0x92746B9BE2F8552C}, {0x3FBC8C33221DC2A1, 0xB7118682DBB66A77},
+    {0x0FABAF3FEAA5334A, 0xE4D5E82392A40515}, {0x29CB4D87F2A7400E, 0x8F05B1163BA6832D},
+    {0x743E20E9EF511012, 0xB2C71D5BCA9023F8}, {0x914DA9246B255416, 0xDF78E4B2BD342CF6},
+    {0x1AD089B6C2F7548E, 0x8BAB8EEFB6409C1A}, {0xA184AC2473B529B1, 0xAE9672ABA3D0C320},
+    {0xC9E5D72D90A2741E, 0xDA3C0F568CC4F3E8}, {0x7E2FA67C7A658892, 0x8865899617FB1871},
+    {0xDDBB901B98FEEAB7, 0xAA7EEBFB9DF9DE8D}, {0x552A74227F3EA565, 0xD51EA6FA85785631},
+    {0xD53A88958F87275F, 0x8533285C936B35DE}, {0x8A892ABAF368F137, 0xA67FF273B8460356},
+    {0x2D2B7569B0432D85, 0xD01FEF10A657842C}, {0x9C3B29620E29FC73, 0x8213F56A67F6B29B},
+    {0x8349F3BA91B47B8F, 0xA298F2C501F45F42}, {0x241C70A936219A73, 0xCB3F2F7642717713},
+    {0xED238CD383AA0110, 0xFE0EFB53D30DD4D7}, {0xF4363804324A40AA, 0x9EC95D1463E8A506},
+    {0xB143C6053EDCD0D5, 0xC67BB4597CE2CE48}, {0xDD94B7868E94050A, 0xF81AA16FDC1B81DA},
+    {0xCA7CF2B4191C8326, 0x9B10A4E5E9913128}, {0xFD1C2F611F63A3F0, 0xC1D4CE1F63F57D72},
+    {0xBC633B39673C8CEC, 0xF24A01A73CF2DCCF}, {0xD5BE0503E085D813, 0x976E41088617CA01},
+    {0x4B2D8644D8A74E18, 0xBD49D14AA79DBC82}, {0xDDF8E7D60ED1219E, 0xEC9C459D51852BA2},
+    {0xCABB90E5C942B503, 0x93E1AB8252F33B45}, {0x3D6A751F3B936243, 0xB8DA1662E7B00A17},
+    {0x0CC512670A783AD4, 0xE7109BFBA19C0C9D}, {0x27FB2B80668B24C5, 0x906A617D450187E2},
+    {0xB1F9F660802DEDF6, 0xB484F9DC9641E9DA}, {0x5E7873F8A0396973, 0xE1A63853BBD26451},
+    {0xDB0B487B6423E1E8, 0x8D07E33455637EB2}, {0x91CE1A9A3D2CDA62, 0xB049DC016ABC5E5F},
+    {0x7641A140CC7810FB, 0xDC5C5301C56B75F7}, {0xA9E904C87FCB0A9D, 0x89B9B3E11B6329BA},
+    {0x546345FA9FBDCD44, 0xAC2820D9623BF429}, {0xA97C177947AD4095, 0xD732290FBACAF133},
+    {0x49ED8EABCCCC485D, 0x867F59A9D4BED6C0}, {0x5C68F256BFFF5A74, 0xA81F301449EE8C70},
+    {0x73832EEC6FFF3111, 0xD226FC195C6A2F8C}, {0xC831FD53C5FF7EAB, 0x83585D8FD9C25DB7},
+    {0xBA3E7CA8B77F5E55, 0xA42E74F3D032F525}, {0x28CE1BD2E55F35EB, 0xCD3A1230C43FB26F},
+    {0x7980D163CF5B81B3, 0x80444B5E7AA7CF85}, {0xD7E105BCC332621F, 0xA0555E361951C366},
+    {0x8DD9472BF3FEFAA7, 0xC86AB5C39FA63440}, {0xB14F98F6F0FEB951, 0xFA856334878FC150},
+    {0x6ED1BF9A569F33D3, 0x9C935E00D4B9D8D2}, {0x0A862F80EC4700C8, 0xC3B8358109E84F07},
+    {0xCD27BB612758C0FA, 0xF4A642E14C6262C8}, {0x8038D51CB897789C, 0x98E7E9CCCFBD7DBD},
+    {0xE0470A63E6BD56C3, 0xBF21E44003ACDD2C}, {0x1858CCFCE06CAC74, 0xEEEA5D5004981478},
+    {0x0F37801E0C43EBC8, 0x95527A5202DF0CCB}, {0xD30560258F54E6BA, 0xBAA718E68396CFFD},
+    {0x47C6B82EF32A2069, 0xE950DF20247C83FD}, {0x4CDC331D57FA5441, 0x91D28B7416CDD27E},
+    {0xE0133FE4ADF8E952, 0xB6472E511C81471D}, {0x58180FDDD97723A6, 0xE3D8F9E563A198E5},
+    {0x570F09EAA7EA7648, 0x8E679C2F5E44FF8F}, {0x2CD2CC6551E513DA, 0xB201833B35D63F73},
+    {0xF8077F7EA65E58D1, 0xDE81E40A034BCF4F}, {0xFB04AFAF27FAF782, 0x8B112E86420F6191},
+    {0x79C5DB9AF1F9B563, 0xADD57A27D29339F6}, {0x18375281AE7822BC, 0xD94AD8B1C7380874},
+    {0x8F2293910D0B15B5, 0x87CEC76F1C830548}, {0xB2EB3875504DDB22, 0xA9C2794AE3A3C69A},
+    {0x5FA60692A46151EB, 0xD433179D9C8CB841}, {0xDBC7C41BA6BCD333, 0x849FEEC281D7F328},
+    {0x12B9B522906C0800, 0xA5C7EA73224DEFF3}, {0xD768226B34870A00, 0xCF39E50FEAE16BEF},
+    {0xE6A1158300D46640, 0x81842F29F2CCE375}, {0x60495AE3C1097FD0, 0xA1E53AF46F801C53},
+    {0x385BB19CB14BDFC4, 0xCA5E89B18B602368}, {0x46729E03DD9ED7B5, 0xFCF62C1DEE382C42},
+    {0x6C07A2C26A8346D1, 0x9E19DB92B4E31BA9}, {0xC7098B7305241885, 0xC5A05277621BE293},
+    {0xB8CBEE4FC66D1EA7, 0xF70867153AA2DB38}, {0x737F74F1DC043328, 0x9A65406D44A5C903},
+    {0x505F522E53053FF2, 0xC0FE908895CF3B44}, {0x647726B9E7C68FEF, 0xF13E34AABB430A15},
+    {0x5ECA783430DC19F5, 0x96C6E0EAB509E64D}, {0xB67D16413D132072, 0xBC789925624C5FE0},
+    {0xE41C5BD18C57E88F, 0xEB96BF6EBADF77D8}, {0x8E91B962F7B6F159, 0x933E37A534CBAAE7},
+    {0x723627BBB5A4ADB0, 0xB80DC58E81FE95A1}, {0xCEC3B1AAA30DD91C, 0xE61136F2227E3B09},
+    {0x213A4F0AA5E8A7B1, 0x8FCAC257558EE4E6}, {0xA988E2CD4F62D19D, 0xB3BD72ED2AF29E1F},
+    {0x93EB1B80A33B8605, 0xE0ACCFA875AF45A7}, {0xBC72F130660533C3, 0x8C6C01C9498D8B88},
+    {0xEB8FAD7C7F8680B4, 0xAF87023B9BF0EE6A}, {0xA67398DB9F6820E1, 0xDB68C2CA82ED2A05},
+    {0x88083F8943A1148C, 0x892179BE91D43A43}, {0x6A0A4F6B948959B0, 0xAB69D82E364948D4},
+    {0x848CE34679ABB01C, 0xD6444E39C3DB9B09}, {0xF2D80E0C0C0B4E11, 0x85EAB0E41A6940E5},
+    {0x6F8E118F0F0E2195, 0xA7655D1D2103911F}, {0x4B7195F2D2D1A9FB, 0xD13EB46469447567},
+};
+
+// 精确表示的10的幂，用于快速路径
+static const double lept_pow10_exact[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+#if defined(__SIZEOF_INT128__)
+__extension__ typedef unsigned __int128 lept_uint128;
+#endif
+
+// 64位乘法的完整128位结果，返回低64位，*hi 为高64位
+static uint64_t lept_umul128(uint64_t a, uint64_t b, uint64_t* hi) {
+#if defined(__SIZEOF_INT128__)
+    lept_uint128 r = (lept_uint128)a * b;
+    *hi = (uint64_t)(r >> 64);
+    return (uint64_t)r;
+#else
+    uint64_t a0 = (uint32_t)a, a1 = a >> 32, b0 = (uint32_t)b, b1 = b >> 32;
+    uint64_t p00 = a0 * b0, p01 = a0 * b1, p10 = a1 * b0, p11 = a1 * b1;
+    uint64_t mid = (p00 >> 32) + (uint32_t)p01 + (uint32_t)p10;
+    *hi = p11 + (p01 >> 32) + (p10 >> 32) + (mid >> 32);
+    return (mid << 32) | (uint32_t)p00;
+#endif
+}
+
+static int lept_clz64(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_clzll(x);
+#else
+    int n = 0;
+    for (; !(x & ((uint64_t)1 << 63)); x <<= 1)
+        n++;
+    return n;
+#endif
+}
+
+static double lept_bits_to_double(uint64_t bits) {
+    double d;
+    memcpy(&d, &bits, sizeof(d));
+    return d;
+}
+
+// Eisel-Lemire：w * 10^e10（w != 0）；无法确定正确舍入、结果为非规格化数或溢出时返回FALSE
+static int lept_eisel_lemire(uint64_t w, int64_t e10, double* d) {
+    const uint64_t* pow10;
+    uint64_t hi, lo, yhi, ylo, mant, exp2;
+    int clz, msb;
+    if (e10 < LEPT_POW10_MIN || e10 > LEPT_POW10_MAX)
+        return FALSE;
+    pow10 = lept_pow10_128[e10 - LEPT_POW10_MIN];
+    // 规格化，217706 / 2^16 ≈ log2(10)
+    clz = lept_clz64(w);
+    w <<= clz;
+    exp2 = (uint64_t)(((217706 * e10) >> 16) + 64 + 1023) - (uint64_t)clz;
+    lo = lept_umul128(w, pow10[1], &hi);
+    // 低位可能向高位进位时，再乘上幂的低64位
+    if ((hi & 0x1FF) == 0x1FF && lo + w < w) {
+        ylo = lept_umul128(w, pow10[0], &yhi);
+        uint64_t merged_hi = hi, merged_lo = lo + yhi;
+        if (merged_lo < lo)
+            merged_hi++;
+        if ((merged_hi & 0x1FF) == 0x1FF && merged_lo + 1 == 0 && ylo + w < w)
+            return FALSE;
+        hi = merged_hi;
+        lo = merged_lo;
+    }
+    // 取54位，多出的1位用于舍入
+    msb = (int)(hi >> 63);
+    mant = hi >> (msb + 9);
+    exp2 -= 1 ^ msb;
+    // 恰好在两个double中间，近似值不足以判断
+    if (lo == 0 && (hi & 0x1FF) == 0 && (mant & 3) == 1)
+        return FALSE;
+    mant += mant & 1;
+    mant >>= 1;
+    if (mant >> 53) {
+        mant >>= 1;
+        exp2++;
+    }
+    if (exp2 - 1 >= 0x7FF - 1)  // exp2 <= 0 或 >= 0x7FF
+        return FALSE;
+    *d = lept_bits_to_double(exp2 << 52 | (mant & (((uint64_t)1 << 52) - 1)));
+    return TRUE;
+}
+
+/* 十进制大数：0.d[0]d[1]...d[nd-1] * 10^dp，超出的非零数字只记录在trunc中 */
+#define LEPT_DECIMAL_DIGITS 800
+#define LEPT_DECIMAL_MAX_SHIFT 60
+
+typedef struct {
+    unsigned char d[LEPT_DECIMAL_DIGITS];
+    int nd, dp, trunc;
+} lept_decimal;
+
+static void lept_decimal_trim(lept_decimal* a) {
+    while (a->nd > 0 && a->d[a->nd - 1] == 0)
+        a->nd--;
+    if (a->nd == 0)
+        a->dp = 0;
+}
+
+// 乘以2^k，k <= LEPT_DECIMAL_MAX_SHIFT：从最低位开始逐位相乘，结果先写入临时缓冲区的尾部
+static void lept_decimal_lshift(lept_decimal* a, int k) {
+    unsigned char buf[LEPT_DECIMAL_DIGITS + 20];
+    int r, w = (int)sizeof(buf), n;
+    uint64_t acc = 0;
+    for (r = a->nd - 1; r >= 0; r--) {
+        acc += (uint64_t)a->d[r] << k;
+        buf[--w] = (unsigned char)(acc % 10);
+        acc /= 10;
+    }
+    for (; acc > 0; acc /= 10)
+        buf[--w] = (unsigned char)(acc % 10);
+    n = (int)sizeof(buf) - w;
+    a->dp += n - a->nd;
+    if (n > LEPT_DECIMAL_DIGITS) {
+        for (r = LEPT_DECIMAL_DIGITS; r < n; r++)
+            if (buf[w + r])
+                a->trunc = TRUE;
+        n = LEPT_DECIMAL_DIGITS;
+    }
+    memcpy(a->d, buf + w, n);
+    a->nd = n;
+    lept_decimal_trim(a);
+}
+
+// 除以2^k，k <= LEPT_DECIMAL_MAX_SHIFT：从最高位开始做长除法
+static void lept_decimal_rshift(lept_decimal* a, int k) {
+    int r = 0, w = 0;
+    uint64_t n = 0, mask = ((uint64_t)1 << k) - 1;
+    // 先取足够多的高位，使第一位商不为0
+    for (; (n >> k) == 0; r++) {
+        if (r >= a->nd) {
+            if (n == 0) {
+                a->nd = 0;
+                return;
+            }
+            for (; (n >> k) == 0; r++)
+                n *= 10;
+            break;
+        }
+        n = n * 10 + a->d[r];
+    }
+    a->dp -= r - 1;
+    for (; r < a->nd; r++) {
+        unsigned char ch = a->d[r];
+        a->d[w++] = (unsigned char)(n >> k);
+        n = (n & mask) * 10 + ch;
+    }
+    for (; n > 0; n = (n & mask) * 10) {
+        if (w < LEPT_DECIMAL_DIGITS)
+            a->d[w++] = (unsigned char)(n >> k);
+        else if (n >> k)
+            a->trunc = TRUE;
+    }
+    a->nd = w;
+    lept_decimal_trim(a);
+}
+
+static void lept_decimal_shift(lept_decimal* a, int k) {
+    if (a->nd == 0)
+        return;
+    for (; k > LEPT_DECIMAL_MAX_SHIFT; k -= LEPT_DECIMAL_MAX_SHIFT)
+        lept_decimal_lshift(a, LEPT_DECIMAL_MAX_SHIFT);
+    for (; k < -LEPT_DECIMAL_MAX_SHIFT; k += LEPT_DECIMAL_MAX_SHIFT)
+        lept_decimal_rshift(a, LEPT_DECIMAL_MAX_SHIFT);
+    if (k > 0)
+        lept_decimal_lshift(a, k);
+    else if (k < 0)
+        lept_decimal_rshift(a, -k);
+}
+
+// 取整数部分，按第一位舍去的数字四舍六入、恰好一半时取偶
+static uint64_t lept_decimal_rounded_integer(const lept_decimal* a) {
+    uint64_t n = 0;
+    int i, up;
+    for (i = 0; i < a->dp && i < a->nd; i++)
+        n = n * 10 + a->d[i];
+    for (; i < a->dp; i++)
+        n *= 10;
+    if (a->dp < 0 || a->dp >= a->nd)
+        up = FALSE;
+    else if (a->d[a->dp] == 5 && a->dp + 1 == a->nd)  // 恰好一半，截断过则实际值更大
+        up = a->trunc || (a->dp > 0 && a->d[a->dp - 1] % 2 == 1);
+    else
+        up = a->d[a->dp] >= 5;
+    return n + up;
+}
+
+// 精确但较慢的转换：[s, end) 是数字的尾数部分（不含符号），exp 是指数部分的值
+static double lept_decimal_to_double(const char* s, const char* end, int64_t exp) {
+    static const int powtab[] = { 1, 3, 6, 9, 13, 16, 19, 23, 26 };
+    lept_decimal a;
+    uint64_t mant;
+    int exp2 = 0, n, dot = FALSE;
+    a.nd = a.dp = 0;
+    a.trunc = FALSE;
+    for (; s < end; s++) {
+        if (*s == '.') {
+            dot = TRUE;
+            a.dp = a.nd;
+        } else if (*s == '0' && a.nd == 0)  // 忽略前导零
+            a.dp--;
+        else if (a.nd < LEPT_DECIMAL_DIGITS)
+            a.d[a.nd++] = (unsigned char)(*s - '0');
+        else if (*s != '0')
+            a.trunc = TRUE;
+    }
+    if (!dot)
+        a.dp = a.nd;
+    lept_decimal_trim(&a);
+    if (a.nd == 0 || a.dp + exp < -330)
+        return 0.0;
+    if (a.dp + exp > 310)
+        return HUGE_VAL;
+    a.dp += (int)exp;
+    // 乘除2的幂，把值调整到 [0.5, 1)
+    while (a.dp > 0) {
+        n = a.dp >= (int)(sizeof(powtab) / sizeof(powtab[0])) ? 27 : powtab[a.dp];
+        lept_decimal_shift(&a, -n);
+        exp2 += n;
+    }
+    while (a.dp < 0 || (a.dp == 0 && a.d[0] < 5)) {
+        n = -a.dp >= (int)(sizeof(powtab) / sizeof(powtab[0])) ? 27 : powtab[-a.dp];
+        lept_decimal_shift(&a, n);
+        exp2 -= n;
+    }
+    exp2--;  // [0.5, 1) => [1, 2)
+    if (exp2 < -1022) {  // 非规格化数
+        lept_decimal_shift(&a, exp2 + 1022);
+        exp2 = -1022;
+    }
+    if (exp2 > 1023)
+        return HUGE_VAL;
+    lept_decimal_shift(&a, 53);
+    mant = lept_decimal_rounded_integer(&a);
+    if (mant == (uint64_t)2 << 52) {  // 舍入后进位
+        mant >>= 1;
+        if (++exp2 > 1023)
+            return HUGE_VAL;
+    }
+    if (!(mant & ((uint64_t)1 << 52)))
+        exp2 = -1023;
+    return lept_bits_to_double((uint64_t)(exp2 + 1023) << 52 | (mant & (((uint64_t)1 << 52) - 1)));
+}
+
+// 解析数字(参考ECMA404-num构成图)，检查语法的同时累积有效数字和指数，再转换为double
 static int lepr_parse_number(lept_context* c, lept_value* v) {
     /* strod识别的数字范围超过json格式要求，需要进行限制 */
-    const char* p = c->json;
-    if (*p == '-') p++;
-    if (*p == '0') p++;
-    else if (ISDIGIT1TO9(*p))
-        for (p++; ISDIGIT(*p); p++) ;
+    const char* p = c->json, *end = c->end, *digits, *mend;
+    uint64_t w = 0;             // 前19位有效数字
+    int nd = 0, trunc = FALSE;  // w 中有效数字的位数；之后是否还有非零数字
+    int64_t e10 = 0, exp = 0;   // 值为 w * 10^e10（截断时略大）；指数部分的值
+    int neg = FALSE, integral = TRUE;  // 是否为整数字面量（没有小数和指数部分）
+    double d, d1;
+#define CH(p) ((p) < end ? *(p) : '\0')
+    if (CH(p) == '-') {
+        neg = TRUE;
+        p++;
+    }
+    digits = p;
+    if (CH(p) == '0') p++;
+    else if (ISDIGIT1TO9(CH(p)))
+        for (; ISDIGIT(CH(p)); p++) {
+            // 整数部分再多收一位，只要不超过UINT64_MAX，使20位的无符号整数也能精确存储
+            if (nd < 19 || (nd == 19 && (w < UINT64_MAX / 10 || (w == UINT64_MAX / 10 && *p <= '5')))) {
+                w = w * 10 + (uint64_t)(*p - '0');
+                nd++;
+            } else {
+                e10++;
+                trunc |= *p != '0';
+            }
+        }
     else
         return LEPT_PARSE_INVALID_VALUE;
-    if (*p == '.') {
+    if (CH(p) == '.') {
+        integral = FALSE;
         p++;
-        if (!ISDIGIT(*p))
+        if (!ISDIGIT(CH(p)))
             return LEPT_PARSE_INVALID_VALUE;
-        for (p++; ISDIGIT(*p); p++) ;
+        for (; ISDIGIT(CH(p)); p++) {
+            if (nd < 19) {
+                w = w * 10 + (uint64_t)(*p - '0');
+                e10--;
+                nd += w != 0;  // 小数点后的前导零不算有效数字
+            } else
+                trunc |= *p != '0';
+        }
     }
-    if (*p == 'e' || *p == 'E') {
+    mend = p;
+    if (CH(p) == 'e' || CH(p) == 'E') {
+        integral = FALSE;
+        int eneg = FALSE;
         p++;
-        if (*p == '+' || *p == '-') p++;
-        if (!ISDIGIT(*p)) return LEPT_PARSE_INVALID_VALUE;
-        for (p++; ISDIGIT(*p); p++) ;
+        if (CH(p) == '+' || CH(p) == '-')
+            eneg = *p++ == '-';
+        if (!ISDIGIT(CH(p))) return LEPT_PARSE_INVALID_VALUE;
+        for (; ISDIGIT(CH(p)); p++)
+            if (exp < 100000)  // 更大的指数结果都一样：溢出或为0
+                exp = exp * 10 + (*p - '0');
+        if (eneg)
+            exp = -exp;
+        e10 += exp;
+    }
+#undef CH
+
+    // 范围内的整数精确存储，-0 仍然是浮点数
+    if (integral && !trunc && e10 == 0 && (!neg || (w != 0 && w <= (uint64_t)1 << 63))) {
+        c->json = p;
+        v->type = LEPT_NUMBER;
+        if (neg) {
+            v->u.i = w == (uint64_t)1 << 63 ? INT64_MIN : -(int64_t)w;
+            v->flags = LEPT_FLAG_INT64;
+        } else if (w <= (uint64_t)INT64_MAX) {
+            v->u.i = (int64_t)w;
+            v->flags = LEPT_FLAG_INT64;
+        } else {
+            v->u.u = w;
+            v->flags = LEPT_FLAG_UINT64;
+        }
+        return LEPT_PARSE_OK;
     }
 
-    // strtod: 从字符串中解析数字, 第二个参数若不为NULL则指向下一个字符
-    v->u.n = strtod(c->json, NULL);
-    if (v->u.n == HUGE_VAL || v->u.n == -HUGE_VAL)
+    // 值在 [10^(nd-1+e10), 10^(nd+e10)) 内
+    if (w == 0 || nd + e10 < -343)
+        d = 0.0;
+    else if (nd - 1 + e10 > 308)
+        return LEPT_PARSE_NUMBER_TOO_BIG;
+#if defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD == 0  // x87的扩展精度会导致两次舍入
+    else if (!trunc && w <= (uint64_t)1 << 53 && e10 >= -22 && e10 <= 22)
+        d = e10 < 0 ? (double)w / lept_pow10_exact[-e10] : (double)w * lept_pow10_exact[e10];
+#endif
+    // 截断时真实值在 w 和 w+1 之间，两端结果相同才能确定
+    else if (!lept_eisel_lemire(w, e10, &d) || (trunc && (w + 1 == 0 || !lept_eisel_lemire(w + 1, e10, &d1) || d != d1)))
+        d = lept_decimal_to_double(digits, mend, exp);
+    if (d == HUGE_VAL)
         return LEPT_PARSE_NUMBER_TOO_BIG;
 
     c->json = p;
+    v->u.n = neg ? -d : d;
     v->type = LEPT_NUMBER;
+    v->flags = 0;
     return LEPT_PARSE_OK;
 }
 
 //  解析 4 位十六进制整数为码点
-static const char* lept_parse_hex4(const char* p, unsigned* u) {
+static const char* lept_parse_hex4(const char* p, const char* end, unsigned* u) {
     *u = 0;
     unsigned v = 0;
+    if (end - p < 4)
+        return NULL;
     for (size_t i = 4; i; i--) {
         if (!ISHEXDIGIT(*p))
             return NULL;
@@ -190,147 +1377,599 @@ static const char* lept_parse_hex4(const char* p, unsigned* u) {
     return p;
 }
 
-// 把这个码点编码成 UTF-8
-static void lept_encode_utf8(lept_context* c, unsigned u) {
+// 把这个码点编码成 UTF-8，写入 p 开始的缓冲区（至多 4 字节），返回写入的字节数
+static size_t lept_encode_utf8(char* p, unsigned u) {
     assert(u >= 0x0000 && u <= 0x10FFFF);
     if (u <= 0x7F) {
-        lept_context_push(c, u & 0xFF);
+        p[0] = u & 0xFF;
+        return 1;
     } else if (u <= 0x7FF) {
-        lept_context_push(c, 0xC0 | ((u >> 6) & 0xFF));
-        lept_context_push(c, 0x80 | ( u       & 0x3F));
+        p[0] = 0xC0 | ((u >> 6) & 0xFF);
+        p[1] = 0x80 | ( u       & 0x3F);
+        return 2;
     } else if (u <= 0xFFFF) {
-        lept_context_push(c, 0xE0 | ((u >> 12) & 0xFF)); /* 0xE0 = 11100000 */
-        lept_context_push(c, 0x80 | ((u >>  6) & 0x3F)); /* 0x80 = 10000000 */
-        lept_context_push(c, 0x80 | ( u        & 0x3F)); /* 0x3F = 00111111 */
+        p[0] = 0xE0 | ((u >> 12) & 0xFF); /* 0xE0 = 11100000 */
+        p[1] = 0x80 | ((u >>  6) & 0x3F); /* 0x80 = 10000000 */
+        p[2] = 0x80 | ( u        & 0x3F); /* 0x3F = 00111111 */
+        return 3;
     } else {
-        lept_context_push(c, 0xF0 | ((u >> 18) & 0xFF));
-        lept_context_push(c, 0x80 | ((u >> 12) & 0x3F));
-        lept_context_push(c, 0x80 | ((u >>  6) & 0x3F));
-        lept_context_push(c, 0x80 | ( u        & 0x3F));
+        p[0] = 0xF0 | ((u >> 18) & 0xFF);
+        p[1] = 0x80 | ((u >> 12) & 0x3F);
+        p[2] = 0x80 | ((u >>  6) & 0x3F);
+        p[3] = 0x80 | ( u        & 0x3F);
+        return 4;
     }
 }
 
-// code refactoring：extract method, c->json => c->stack => *str
-// 注意这里用到了双指针，因为要改变指针的值，而单指针只能改变指向的元素
-static int lept_parse_string_raw(lept_context* c, char** str, size_t* size) {
+// 解析一个转义序列，*pp 指向 '\\' 之后的字符，解码结果（至多 4 字节）写入 buf
+// 成功时 *pp 移到转义序列之后。转义序列解码后不会比原文更长，所以可以就地解码
+static int lept_parse_escape(const char** pp, const char* end, char* buf, size_t* len) {
+    const char* p = *pp;
+    unsigned u, L;
+    if (p == end)
+        return LEPT_PARSE_INVALID_STRING_ESCAPE;
+    switch (*p++) {
+        case '\"': *buf = '\"'; break;
+        case '\\': *buf = '\\'; break;
+        case '/':  *buf =  '/'; break;
+        case 'b':  *buf = '\b'; break;
+        case 'f':  *buf = '\f'; break;
+        case 'n':  *buf = '\n'; break;
+        case 'r':  *buf = '\r'; break;
+        case 't':  *buf = '\t'; break;
+        case 'u':
+            if (!(p = lept_parse_hex4(p, end, &u)))
+                return LEPT_PARSE_INVALID_UNICODE_HEX;
+            // 处理代理对surrogate pair
+            if ( u >= 0xD800 && u <= 0xDBFF ) {
+                if ( end - p < 2 || *p++ != '\\' )
+                    return LEPT_PARSE_INVALID_UNICODE_SURROGATE;
+                if ( *p++ != 'u' )
+                    return LEPT_PARSE_INVALID_UNICODE_SURROGATE;
+                p = lept_parse_hex4(p, end, &L);
+                if (!p || L < 0xDC00 || L > 0xDFFF )
+                    return LEPT_PARSE_INVALID_UNICODE_SURROGATE;
+                u = 0x10000 + (u - 0xD800) * 0x400 + (L - 0xDC00);
+            }
+            *len = lept_encode_utf8(buf, u);
+            *pp = p;
+            return LEPT_PARSE_OK;
+        default:
+            return LEPT_PARSE_INVALID_STRING_ESCAPE;
+    }
+    *len = 1;
+    *pp = p;
+    return LEPT_PARSE_OK;
+}
+
+// 就地解析字符串：转义序列在输入缓冲区内解码，*str 直接指向缓冲区
+static int lept_parse_string_insitu(lept_context* c, char** str, size_t* size) {
     EXPECT(c, '\"');
+    const char* p = c->json;
+    char* head = (char*)c->json, *w = head; // 写指针永远不会超过读指针
+    size_t len;
+    int ret;
+    while (1) {
+        const char* q = lept_scan_string(p, c->end);
+        if (w != p)  // 出现过转义后，普通字节需要整段前移
+            memmove(w, p, q - p);
+        w += q - p;
+        if ((p = q) == c->end)
+            return LEPT_PARSE_MISS_QUOTATION_MARK;
+        char ch = *p++;
+        switch (ch) {
+            case '\"':
+                *w = '\0';  // 写在闭合引号或其之前，不会越界
+                *str = head;
+                *size = w - head;
+                c->json = p;
+                return LEPT_PARSE_OK;
+            case '\\':
+                if ((ret = lept_parse_escape(&p, c->end, w, &len)) != LEPT_PARSE_OK)
+                    return ret;
+                w += len;
+                break;
+            default:
+                return LEPT_PARSE_INVALID_STRING_CHAR;
+        }
+    }
+}
+
+// 把字符串解码到c->stack上，c->json => c->stack
+// c->json 指向开引号之后，q 是已经扫描到的第一个特殊字节
+// 成功时解码后的 *size 个字节留在栈顶，由调用者弹出；失败时栈恢复原状
+static int lept_parse_string_escaped(lept_context* c, const char* q, size_t* size) {
     const char* p = c->json;
     // 如果数组里包含字符串，那么c->stack只用到后半部分，前半部分是lept_value
     // 因此需要记录栈的进入点、栈的使用长度
-    size_t head = c->top; 
-    unsigned u, L;
+    size_t head = c->top, len;
+    char buf[4];
+    int ret;
     while (1) {
+        PUTS(c, p, q - p);  // 普通字节整段压栈
+        if ((p = q) == c->end)
+            STRING_ERROR(LEPT_PARSE_MISS_QUOTATION_MARK);
         char ch = *p++;
         switch (ch) {
             case '\"':
                 *size = c->top - head;
-                // c->stack只能临时存放字符串，迟早要拷贝到新的字符串，否则free(c->stack)会销毁掉字符串
-                memcpy(*str = (char*)malloc((*size + 1) * sizeof(char)), lept_context_pop(c, *size), *size);
-                // WARN：如果改成*str[*size] = '\0'; 将是一个严重的BUG，
-                //      根据运算符结合律，该式等价于*(str[*size])显然偏离原意
-                (*str)[*size] = '\0'; // ！！！字符串拷贝不要忘了末尾的空字符。或者写作：*(*str + *size) = '\0';
-                 c->json = p;
+                c->json = p;
                 return LEPT_PARSE_OK;
-            case '\0':
-                STRING_ERROR(LEPT_PARSE_MISS_QUOTATION_MARK);
             case '\\':
-                switch (*p++) {
-                    case '\"':lept_context_push(c, '\"'); break;
-                    case '\\':lept_context_push(c, '\\'); break;
-                    case '/': lept_context_push(c,  '/'); break;
-                    case 'b': lept_context_push(c, '\b'); break;
-                    case 'f': lept_context_push(c, '\f'); break;
-                    case 'n': lept_context_push(c, '\n'); break;
-                    case 'r': lept_context_push(c, '\r'); break;
-                    case 't': lept_context_push(c, '\t'); break;
-                    case 'u':
-                        if (!(p = lept_parse_hex4(p, &u)))
-                            STRING_ERROR(LEPT_PARSE_INVALID_UNICODE_HEX);
-                        // 处理代理对surrogate pair
-                        if ( u >= 0xD800 && u <= 0xDBFF ) {
-                            if ( *p++ != '\\' )
-                                STRING_ERROR(LEPT_PARSE_INVALID_UNICODE_SURROGATE);
-                            if ( *p++ != 'u' )
-                                STRING_ERROR(LEPT_PARSE_INVALID_UNICODE_SURROGATE);                     
-                            p = lept_parse_hex4(p, &L);
-                            if (!p || L < 0xDC00 || L > 0xDFFF )
-                                STRING_ERROR(LEPT_PARSE_INVALID_UNICODE_SURROGATE);
-                            u = 0x10000 + (u - 0xD800) * 0x400 + (L - 0xDC00);
-                        }
-                        lept_encode_utf8(c, u);
-                        break;
-                    default:
-                        STRING_ERROR(LEPT_PARSE_INVALID_STRING_ESCAPE);
-                }
+                if ((ret = lept_parse_escape(&p, c->end, buf, &len)) != LEPT_PARSE_OK)
+                    STRING_ERROR(ret);
+                PUTS(c, buf, len);
                 break; // !!! 小小break，容易忽视，问题多多
-            default:
-                if ((unsigned char)ch < 0x20)
-                    STRING_ERROR(LEPT_PARSE_INVALID_STRING_CHAR);
-                lept_context_push(c, ch);
+            default:  // 只可能是控制字符
+                STRING_ERROR(LEPT_PARSE_INVALID_STRING_CHAR);
         }
+        q = lept_scan_string(p, c->end);
     }  
 }
 
-// 解析字符串，c->json => c->stack => v->u.s.str
-static int lept_parse_string(lept_context* c, lept_value* v) {
+static int lept_parse_string_stack(lept_context* c, size_t* size) {
+    EXPECT(c, '\"');
+    return lept_parse_string_escaped(c, lept_scan_string(c->json, c->end), size);
+}
+
+// 解码字符串但不分配：没有转义时 *str 直接指向输入，否则解码到栈上再弹出
+// 弹出的内容在下一次压栈之前有效，调用者要立即拷贝
+static int lept_parse_string_span(lept_context* c, const char** str, size_t* size) {
+    const char* q;
     int ret;
-    char* s;
-    size_t len;
-    if ((ret = lept_parse_string_raw(c, &s, &len)) == LEPT_PARSE_OK) {
-        lept_set_string(v, s, len);
-        free(s);
+    EXPECT(c, '\"');
+    q = lept_scan_string(c->json, c->end);
+    if (q < c->end && *q == '\"') {  // 没有转义：不经过栈
+        *str = c->json;
+        *size = q - c->json;
+        c->json = q + 1;
+        return LEPT_PARSE_OK;
     }
-    return ret;
+    if ((ret = lept_parse_string_escaped(c, q, size)) != LEPT_PARSE_OK)
+        return ret;
+    *str = lept_context_pop(c, *size);
+    return LEPT_PARSE_OK;
 }
 
-static int lept_parse_value(lept_context* c, lept_value* v); /* 前向声明 */
+// code refactoring：extract method, c->json => c->stack => *str
+// 注意这里用到了双指针，因为要改变指针的值，而单指针只能改变指向的元素
+static int lept_parse_string_raw(lept_context* c, char** str, size_t* size) {
+    const char* p;
+    int ret;
+    if (c->insitu)
+        return lept_parse_string_insitu(c, str, size);
+    if ((ret = lept_parse_string_span(c, &p, size)) != LEPT_PARSE_OK)
+        return ret;
+    // c->stack只能临时存放字符串，迟早要拷贝到新的字符串，否则free(c->stack)会销毁掉字符串
+    memcpy(*str = (char*)lept_context_alloc(c, *size + 1), p, *size);
+    // WARN：如果改成*str[*size] = '\0'; 将是一个严重的BUG，
+    //      根据运算符结合律，该式等价于*(str[*size])显然偏离原意
+    (*str)[*size] = '\0'; // ！！！字符串拷贝不要忘了末尾的空字符。或者写作：*(*str + *size) = '\0';
+    return LEPT_PARSE_OK;
+}
 
-// 解析数组
+// 短字符串直接存放在值内，不分配内存
+static void lept_set_short_string(lept_value* v, const char* s, size_t len) {
+    assert(len <= LEPT_SHORT_STRING_MAX);
+    memcpy(v->u.ss.str, s, len);
+    v->u.ss.str[len] = '\0';
+    v->u.ss.size = (unsigned char)len;
+    v->type = LEPT_STRING;
+    v->flags = LEPT_FLAG_SHORT;
+}
+
+// 解析字符串，c->json => c->stack => v->u.s.str
+// 短字符串存入值内；其余的从输入或栈拷贝到一次分配的副本中
+static int lept_parse_string(lept_context* c, lept_value* v) {
+    const char* p;
+    char* s;
+    size_t len;
+    int ret;
+    if (c->insitu) {  // 借用输入缓冲区
+        if ((ret = lept_parse_string_insitu(c, &s, &len)) == LEPT_PARSE_OK) {
+            if (!LEPT_SIZE_FITS(len))
+                return LEPT_PARSE_TOO_LARGE;
+            v->u.s.str = s;
+            v->u.s.size = len;
+            v->type = LEPT_STRING;
+            v->flags = LEPT_FLAG_BORROWED;
+        }
+        return ret;
+    }
+    if ((ret = lept_parse_string_span(c, &p, &len)) != LEPT_PARSE_OK)
+        return ret;
+    if (len <= LEPT_SHORT_STRING_MAX) {
+        lept_set_short_string(v, p, len);
+        return LEPT_PARSE_OK;
+    }
+    if (!LEPT_SIZE_FITS(len))
+        return LEPT_PARSE_TOO_LARGE;
+    memcpy(s = (char*)lept_context_alloc(c, len + 1), p, len);
+    s[len] = '\0';
+    v->u.s.str = s;
+    v->u.s.size = len;
+    v->type = LEPT_STRING;
+    if (c->arena)  // 借用arena中的副本
+        v->flags = LEPT_FLAG_BORROWED;
+    return LEPT_PARSE_OK;
+}
+
+static int lept_parse_value(lept_context* c, lept_value* v); /* 前向声明 */
+
+// 能否存入紧凑的数字数组：整数不超过2^53，转换为double不损失精度
+static int lept_number_packable(const lept_value* e) {
+    if (e->type != LEPT_NUMBER || (e->flags & LEPT_FLAG_UINT64))
+        return FALSE;
+    return !(e->flags & LEPT_FLAG_INT64) || (e->u.i >= -(INT64_C(1) << 53) && e->u.i <= INT64_C(1) << 53);
+}
+
+// 把 size 个可紧凑存储的数字存为double数组，n 由调用者在堆上分配
+static void lept_set_packed(lept_value* v, double* n, const lept_value* e, size_t size) {
+    for (size_t i = 0; i < size; i++)
+        n[i] = lept_get_number(&e[i]);
+    v->type = LEPT_ARRAY;
+    v->flags = LEPT_FLAG_PACKED;
+    v->u.a.e = (lept_value*)n;
+    v->u.a.size = size;
+    LEPT_SET_ARRAY_CAPACITY(v, size);
+}
+
+/*
+* 投影路径的前缀树：每个结点是路径中的一个token，"*" 匹配任意键或下标
+* 结点和解码后的token都从临时arena分配，lept_parse_projected 返回前一起释放
+*/
+struct t_lept_path_node {
+    const char* key;        // 解码后的token（~1 => '/'，~0 => '~'）
+    size_t len;
+    size_t index;           // token 是数组下标时的值，否则为 LEPT_KEY_NOT_EXIST
+    int wildcard;           // token 为 "*"
+    int leaf;               // 有路径在此结束：保留整个子树
+    lept_path_node* child;  // 第一个子结点
+    lept_path_node* next;   // 下一个兄弟结点
+};
+
+// 路径token作为数组下标：不以0开头（"0"本身除外）的十进制数，否则返回 LEPT_KEY_NOT_EXIST
+static size_t lept_token_index(const char* key, size_t len) {
+    size_t i;
+    if (len == 0 || len >= 20 || (key[0] == '0' && len > 1))
+        return LEPT_KEY_NOT_EXIST;
+    for (i = 0; i < len; i++)
+        if (!ISDIGIT(key[i]))
+            return LEPT_KEY_NOT_EXIST;
+    return (size_t)strtoull(key, NULL, 10);
+}
+
+// 找到token相同的子结点，没有则新建
+static lept_path_node* lept_path_add(lept_arena* a, lept_path_node* parent, const char* key, size_t len, int wildcard) {
+    lept_path_node* n;
+    for (n = parent->child; n; n = n->next)
+        if (n->wildcard == wildcard && n->len == len && memcmp(n->key, key, len) == 0)
+            return n;
+    n = (lept_path_node*)lept_arena_alloc(a, sizeof(lept_path_node));
+    n->key = key;
+    n->len = len;
+    n->wildcard = wildcard;
+    n->leaf = 0;
+    n->child = NULL;
+    n->next = parent->child;
+    parent->child = n;
+    n->index = wildcard ? LEPT_KEY_NOT_EXIST : lept_token_index(key, len);
+    return n;
+}
+
+// 路径是否合法：空字符串，或以'/'开头且'~'之后只跟'0'或'1'（JSON Pointer 的写法）
+static int lept_path_valid(const char* path) {
+    if (path[0] != '\0' && path[0] != '/')
+        return FALSE;
+    for (; *path; path++)
+        if (*path == '~' && path[1] != '0' && path[1] != '1')
+            return FALSE;
+    return TRUE;
+}
+
+// 把一条合法的路径加入前缀树
+static void lept_path_insert(lept_arena* a, lept_path_node* root, const char* path) {
+    lept_path_node* n = root;
+    assert(lept_path_valid(path));
+    while (*path == '/') {
+        const char* p = ++path;
+        size_t len = 0;
+        char* key;
+        while (*path && *path != '/')
+            path++;
+        key = (char*)lept_arena_alloc(a, path - p + 1);
+        for (; p < path; p++)
+            if (*p == '~' && p + 1 < path && (p[1] == '0' || p[1] == '1'))
+                key[len++] = *++p == '0' ? '~' : '/';
+            else
+                key[len++] = *p;
+        key[len] = '\0';
+        n = lept_path_add(a, n, key, len, len == 1 && key[0] == '*');
+    }
+    n->leaf = 1;
+}
+
+// 把 src 的子树并入 dst
+static void lept_path_merge(lept_arena* a, lept_path_node* dst, const lept_path_node* src) {
+    dst->leaf |= src->leaf;
+    for (src = src->child; src; src = src->next)
+        lept_path_merge(a, lept_path_add(a, dst, src->key, src->len, src->wildcard), src);
+}
+
+// "*" 与具体的token并存时，把 "*" 的子树并入每个具体的兄弟结点，这样匹配时只需取其中一个
+static void lept_path_resolve(lept_arena* a, lept_path_node* n) {
+    lept_path_node *w = NULL, *k;
+    for (k = n->child; k; k = k->next)
+        if (k->wildcard)
+            w = k;
+    for (k = n->child; k; k = k->next) {
+        if (w && k != w)
+            lept_path_merge(a, k, w);
+        lept_path_resolve(a, k);
+    }
+}
+
+// 查找匹配键（key为NULL时匹配下标）的子结点：具体的token优先，其次是 "*"
+static const lept_path_node* lept_path_match(const lept_path_node* n, const char* key, size_t len, size_t index) {
+    const lept_path_node* w = NULL;
+    for (n = n->child; n; n = n->next)
+        if (n->wildcard)
+            w = n;
+        else if (key ? n->len == len && memcmp(n->key, key, len) == 0 : n->index == index)
+            return n;
+    return w;
+}
+
+// 投影时解析或跳过下一个值：n 为匹配的子结点。路径终点完整解析，路径中间只进入数组和对象
+// 返回 LEPT_PARSE_OK 且 *kept 为FALSE表示该值已跳过
+static int lept_parse_projected_value(lept_context* c, lept_value* v, const lept_path_node* n, int* kept) {
+    const lept_path_node* proj = c->proj;
+    size_t end;
+    int ret;
+    if (n && (n->leaf || PEEK(c) == '[' || PEEK(c) == '{')) {
+        *kept = TRUE;
+        c->proj = n->leaf ? NULL : n;
+        ret = lept_parse_value(c, v);
+        c->proj = proj;
+        return ret;
+    }
+    *kept = FALSE;
+    if ((ret = lept_skip_value(c->json, c->end - c->json, &end)) == LEPT_PARSE_OK)
+        c->json += end;
+    return ret;
+}
+
+// 解析数组
 // literal/num：c->json => e => c->stack前端, 
 // 字符串/数组：    c->json => c->stack后端 => e => c->stack前端
 // 最终，      c->satck前端 => v->u.a.e
 static int lept_parse_array(lept_context* c, lept_value* v) {
-    size_t size = 0;
+    size_t size = 0, index = 0;
     lept_value e;
-    int ret;
+    int ret, packable = TRUE, kept = TRUE;
     EXPECT(c, '[');
     lept_parse_whitespace(c);  // 跳空白
-    if (*c->json == ']') {
+    if (PEEK(c) == ']') {
         c->json++;
         v->type = LEPT_ARRAY;
         v->u.a.size = 0;
         v->u.a.e = NULL;
+        LEPT_SET_ARRAY_CAPACITY(v, 0);
         return LEPT_PARSE_OK;
     }
     while (1) {
         lept_init(&e);
-        if ((ret = lept_parse_value(c, &e)) != LEPT_PARSE_OK)
+        ret = c->proj ? lept_parse_projected_value(c, &e, lept_path_match(c->proj, NULL, 0, index++), &kept)
+                      : lept_parse_value(c, &e);
+        if (ret != LEPT_PARSE_OK)
             // 栈内存在临时值，需要弹出并释放，且栈顶归零
             ARRARY_ERROR(ret);
-        // 压入结构体lept_value：lept_context_push_len是在c.stack中预留一个lept_value大小的空白空间，然后用memcpy给它赋值
-        memcpy(lept_context_push_len(c, sizeof(lept_value)), &e, sizeof(lept_value));
-        size++;
+        if (kept) {
+            // 压入结构体lept_value：lept_context_push_len是在c.stack中预留一个lept_value大小的空白空间，然后用memcpy给它赋值
+            memcpy(lept_context_push_len(c, sizeof(lept_value)), &e, sizeof(lept_value));
+            size++;
+            packable = packable && lept_number_packable(&e);
+        }
         /*!!! 误以为要释放e.s.str或者e.a.e，但是c->stack[n].s.str或者c->stack[n].a.e也指向同一块区域
          *    因此无需释放e，因为即便e被销毁，这些heap-alloced memory仍然有c内部指针指向它们。但要注意在最后释放掉*/
         // lept_free(&e); 
         lept_parse_whitespace(c);
-        if (*c->json == ',') {
+        if (PEEK(c) == ',') {
             c->json++;
             lept_parse_whitespace(c);
-        } else if (*c->json == ']') {
+        } else if (PEEK(c) == ']') {
             c->json++;
+            if (!LEPT_SIZE_FITS(size))
+                ARRARY_ERROR(LEPT_PARSE_TOO_LARGE);
+            // 纯数字数组按实际大小存为double。arena中不这样做，lept_get_number_array 会在arena内就地转换
+            if (packable && size >= LEPT_PACKED_ARRAY_THRESHOLD && !c->arena) {
+                const lept_value* e = (const lept_value*)lept_context_pop(c, size * sizeof(lept_value));
+                lept_set_packed(v, (double*)lept_heap_realloc(NULL, size * sizeof(double)), e, size);
+                return LEPT_PARSE_OK;
+            }
+            if (c->arena) {  // arena中的数组按实际大小分配，不留冗余
+                v->type = LEPT_ARRAY;
+                v->flags = LEPT_FLAG_BORROWED;
+                v->u.a.size = size;
+                LEPT_SET_ARRAY_CAPACITY(v, size);
+                size *= sizeof(lept_value);
+                memcpy(v->u.a.e = (lept_value*)lept_arena_alloc(c->arena, size), lept_context_pop(c, size), size);
+                return LEPT_PARSE_OK;
+            }
             lept_set_array(v, size * 2); // 初始capacity有一倍的冗余
             v->u.a.size = size;
             size *= sizeof(lept_value);
             // !!! 通过memcpy，c->stack[n].s.str或者c->stack[n].a.e指向的分配空间
             //     又转交给了v->u.a.e[n]管理，最终要在lept_free()中释放
-            memcpy(v->u.a.e, lept_context_pop(c, size), size);
+            if (size)  // 投影时元素可能全被跳过
+                memcpy(v->u.a.e, lept_context_pop(c, size), size);
             return LEPT_PARSE_OK;
         } else
             ARRARY_ERROR(LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET);
     }
 }
 
+/*
+* 对象的哈希索引：开放寻址（线性探测）的桶数组，与成员数组放在同一块内存里，紧跟在 m[capacity] 之后
+* 成员仍按插入顺序存放，遍历和stringify不受影响；桶只记录成员下标，成员移动或容量变化时重建
+*/
+typedef struct {
+    uint32_t hash;   // 键的哈希值，探测时先比较它
+    uint32_t index;  // 成员下标 + 1，0 表示空桶
+} lept_bucket;
+
+#define LEPT_BUCKETS(v) ((lept_bucket*)((v)->u.o.m + LEPT_OBJECT_CAPACITY(v)))
+
+// 桶数是2的幂，负载因子不超过0.5
+static size_t lept_bucket_count(size_t capacity) {
+    size_t n = 8;
+    while (n < capacity * 2)
+        n <<= 1;
+    return n;
+}
+
+static size_t lept_object_bytes(size_t capacity, int hashed) {
+    return capacity * sizeof(lept_member) + (hashed ? lept_bucket_count(capacity) * sizeof(lept_bucket) : 0);
+}
+
+// FNV-1a
+static uint32_t lept_hash_key(const char* k, size_t len) {
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < len; i++)
+        h = (h ^ (unsigned char)k[i]) * 16777619u;
+    return h;
+}
+
+static void lept_object_index_insert(lept_value* v, size_t index) {
+    lept_bucket* b = LEPT_BUCKETS(v);
+    size_t mask = lept_bucket_count(LEPT_OBJECT_CAPACITY(v)) - 1;
+    uint32_t h = lept_hash_key(v->u.o.m[index].k, v->u.o.m[index].klen);
+    size_t i = h & mask;
+    while (b[i].index)
+        i = (i + 1) & mask;
+    b[i].hash = h;
+    b[i].index = (uint32_t)(index + 1);
+}
+
+static void lept_object_index_rebuild(lept_value* v) {
+    memset(LEPT_BUCKETS(v), 0, lept_bucket_count(LEPT_OBJECT_CAPACITY(v)) * sizeof(lept_bucket));
+    for (size_t i = 0; i < v->u.o.size; i++)
+        lept_object_index_insert(v, i);
+}
+
+// 按新容量重新分配成员数组（以及索引）；借用的成员数组拷贝到堆上
+static void lept_object_realloc(lept_value* v, size_t capacity) {
+    size_t bytes = lept_object_bytes(capacity, v->flags & LEPT_FLAG_HASHED);
+    assert(capacity >= v->u.o.size);
+    if (v->flags & LEPT_FLAG_BORROWED) {
+        lept_member* m = (lept_member*)lept_heap_realloc(NULL, bytes);
+        memcpy(m, v->u.o.m, v->u.o.size * sizeof(lept_member));
+        v->u.o.m = m;
+        v->flags &= ~LEPT_FLAG_BORROWED;
+    } else
+        v->u.o.m = (lept_member*)lept_heap_realloc(v->u.o.m, bytes);
+    LEPT_SET_OBJECT_CAPACITY(v, capacity);
+    if (v->flags & LEPT_FLAG_HASHED)
+        lept_object_index_rebuild(v);
+}
+
+// 为对象建立索引
+static void lept_object_hash(lept_value* v) {
+    assert(v->u.o.size <= UINT32_MAX);
+    if (v->flags & LEPT_FLAG_HASHED)
+        return;
+    v->flags |= LEPT_FLAG_HASHED;
+    lept_object_realloc(v, LEPT_OBJECT_CAPACITY(v));
+}
+
+struct t_lept_keypool_slot {
+    const char* k;  // NULL表示空槽
+    size_t len;
+    uint32_t hash;
+};
+
+void lept_keypool_init(lept_keypool* p) {
+    assert(p != NULL);
+    lept_arena_init(&p->arena, 0);
+    p->slots = NULL;
+    p->count = p->capacity = 0;
+}
+
+void lept_keypool_free(lept_keypool* p) {
+    assert(p != NULL);
+    lept_arena_free(&p->arena);
+    free(p->slots);
+    p->slots = NULL;
+    p->count = p->capacity = 0;
+}
+
+// 槽数翻倍，已驻留的键按保存的哈希值重新放置，键本身不移动
+static void lept_keypool_grow(lept_keypool* p) {
+    size_t capacity = p->capacity ? p->capacity * 2 : LEPT_KEYPOOL_INIT_SIZE;
+    lept_keypool_slot* slots = (lept_keypool_slot*)calloc(capacity, sizeof(lept_keypool_slot));
+    for (size_t i = 0; i < p->capacity; i++)
+        if (p->slots[i].k) {
+            size_t j = p->slots[i].hash & (capacity - 1);
+            while (slots[j].k)
+                j = (j + 1) & (capacity - 1);
+            slots[j] = p->slots[i];
+        }
+    free(p->slots);
+    p->slots = slots;
+    p->capacity = capacity;
+}
+
+const char* lept_keypool_intern(lept_keypool* p, const char* key, size_t len) {
+    lept_keypool_slot* slot;
+    uint32_t h;
+    size_t i, mask;
+    char* k;
+    assert(p != NULL && key != NULL);
+    if ((p->count + 1) * 2 > p->capacity)  // 负载因子不超过 1/2
+        lept_keypool_grow(p);
+    h = lept_hash_key(key, len);
+    mask = p->capacity - 1;
+    for (i = h & mask; p->slots[i].k; i = (i + 1) & mask) {
+        slot = &p->slots[i];
+        if (slot->hash == h && slot->len == len && memcmp(slot->k, key, len) == 0)
+            return slot->k;
+    }
+    k = (char*)lept_arena_alloc(&p->arena, len + 1);
+    memcpy(k, key, len);
+    k[len] = '\0';
+    slot = &p->slots[i];
+    slot->k = k;
+    slot->len = len;
+    slot->hash = h;
+    p->count++;
+    return k;
+}
+
+// 解析键：有键池时驻留到池中，不转义的键直接从输入驻留，否则同 lept_parse_string_raw
+static int lept_parse_key(lept_context* c, char** str, size_t* size) {
+    const char* p;
+    int ret;
+    if (!c->keys)
+        return lept_parse_string_raw(c, str, size);
+    if ((ret = lept_parse_string_span(c, &p, size)) != LEPT_PARSE_OK)
+        return ret;
+    *str = (char*)lept_keypool_intern(c->keys, p, *size);
+    return LEPT_PARSE_OK;
+}
+
+// 投影时的键：先在输入中定位，只有匹配路径的键才拷贝出来，*n 为匹配的子结点
+static int lept_parse_key_projected(lept_context* c, char** str, size_t* size, const lept_path_node** n) {
+    const char* p;
+    int ret;
+    if ((ret = lept_parse_string_span(c, &p, size)) != LEPT_PARSE_OK)
+        return ret;
+    if ((*n = lept_path_match(c->proj, p, *size, 0)) != NULL) {
+        memcpy(*str = (char*)lept_context_alloc(c, *size + 1), p, *size);
+        (*str)[*size] = '\0';
+    }
+    return LEPT_PARSE_OK;
+}
+
 // 解析对象
 // key: c->json => c->stack后端 => m.k
 // value: c->json => m.v
@@ -338,109 +1977,1109 @@ static int lept_parse_array(lept_context* c, lept_value* v) {
 static int lept_parse_object(lept_context* c, lept_value* v) {
     size_t size = 0;
     lept_member m;
-    int ret;
+    const lept_path_node* n = NULL;
+    int ret, kept = TRUE;
     EXPECT(c, '{');
     lept_parse_whitespace(c);
-    if (*c->json == '}') {
+    if (PEEK(c) == '}') {
         c->json++;
         v->type = LEPT_OBJECT;
         v->u.o.m = NULL;
         v->u.o.size = 0;
+        LEPT_SET_OBJECT_CAPACITY(v, 0);
         return LEPT_PARSE_OK;
     }
     while (1) {
         lept_init(&m.v);
         m.k = NULL;/* ownership is transferred to member on stack */
         /* parse key to m.k, m.klen */
-        if (*c->json != '\"') {
-            free(m.k);
+        if (PEEK(c) != '\"')
             OBJECT_ERROR(LEPT_PARSE_MISS_KEY);
-        }
-        if ((ret = lept_parse_string_raw(c, &m.k, &m.klen)) != LEPT_PARSE_OK) {
-            free(m.k);
+        ret = c->proj ? lept_parse_key_projected(c, &m.k, &m.klen, &n) : lept_parse_key(c, &m.k, &m.klen);
+        if (ret != LEPT_PARSE_OK)
             OBJECT_ERROR(LEPT_PARSE_MISS_KEY);
-        }
         /* parse ws colon ws */
         lept_parse_whitespace(c);
-        if (*c->json == ':') {
+        if (PEEK(c) == ':') {
             c->json++;
             lept_parse_whitespace(c);
         } else {
-            free(m.k);
+            lept_context_free(c, m.k);
             OBJECT_ERROR(LEPT_PARSE_MISS_COLON);
         }
         /* parse value */
-        if ((ret = lept_parse_value(c, &m.v)) != LEPT_PARSE_OK)
+        ret = c->proj ? lept_parse_projected_value(c, &m.v, n, &kept) : lept_parse_value(c, &m.v);
+        if (ret != LEPT_PARSE_OK) {
+            lept_context_free(c, m.k);
             OBJECT_ERROR(ret);
-        memcpy(lept_context_push_len(c, sizeof(lept_member)), &m, sizeof(lept_member));
-        size++;
+        }
+        if (kept) {
+            memcpy(lept_context_push_len(c, sizeof(lept_member)), &m, sizeof(lept_member));
+            size++;
+        } else
+            lept_context_free(c, m.k);
 
         lept_parse_whitespace(c);
-        if (*c->json == ',') {
+        if (PEEK(c) == ',') {
             c->json++;
             lept_parse_whitespace(c);
-        } else if (*c->json == '}') {
+        } else if (PEEK(c) == '}') {
             c->json++;
+            if (!LEPT_SIZE_FITS(size))
+                OBJECT_ERROR(LEPT_PARSE_TOO_LARGE);
+            if (c->arena) {  // 索引也从arena分配，紧跟在成员数组之后
+                int hashed = size >= LEPT_OBJECT_HASH_THRESHOLD;
+                v->type = LEPT_OBJECT;
+                v->flags = LEPT_FLAG_BORROWED | LEPT_FLAG_KEYS_BORROWED | (hashed ? LEPT_FLAG_HASHED : 0);
+                v->u.o.size = size;
+                v->u.o.m = (lept_member*)lept_arena_alloc(c->arena, lept_object_bytes(size, hashed));
+                LEPT_SET_OBJECT_CAPACITY(v, size);
+                memcpy(v->u.o.m, lept_context_pop(c, size * sizeof(lept_member)), size * sizeof(lept_member));
+                if (hashed)
+                    lept_object_index_rebuild(v);
+                return LEPT_PARSE_OK;
+            }
             lept_set_object(v, size * 2);
+            if (c->insitu || c->keys)  // 键指向输入缓冲区或键池
+                v->flags = LEPT_FLAG_KEYS_BORROWED;
             v->u.o.size = size;
-            size *= sizeof(lept_member);
-            memcpy(v->u.o.m, lept_context_pop(c, size), size);
+            if (size)
+                memcpy(v->u.o.m, lept_context_pop(c, size * sizeof(lept_member)), size * sizeof(lept_member));
+            if (size >= LEPT_OBJECT_HASH_THRESHOLD)
+                lept_object_hash(v);
             return LEPT_PARSE_OK;
         } else
             OBJECT_ERROR(LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET);
     }
 }
 
-// 解析第一个非空字符
-static int lept_parse_value(lept_context* c, lept_value* v) {
-    switch (*c->json) {
-        case '\0':  return LEPT_PARSE_EXPECT_VALUE;  // 纯空白行
-        case 't':   return lept_parse_literal(c, v, "true", LEPT_TRUE);
-        case 'f':   return lept_parse_literal(c, v, "false", LEPT_FALSE);
-        case 'n':   return lept_parse_literal(c, v, "null", LEPT_NULL);
-        case '"':   return lept_parse_string(c, v);
-        case '[':   return lept_parse_array(c,v);
-        case '{':   return lept_parse_object(c, v);
-        default:    return lepr_parse_number(c, v);
+// 跳过字符串：*pp 指向开引号之后，成功时指向闭引号之后。不检查转义和控制字符
+static int lept_skip_string(const char** pp, const char* end) {
+    const char* p = *pp, *q;
+    while (1) {
+        q = lept_scan_string(p, end);
+        if (q == end || (*q == '\\' && q + 1 == end))
+            return LEPT_PARSE_MISS_QUOTATION_MARK;
+        if (*q == '\"')
+            break;
+        p = q + (*q == '\\' ? 2 : 1);  // 转义的下一个字节不可能结束字符串
+    }
+    *pp = q + 1;
+    return LEPT_PARSE_OK;
+}
+
+// 跳过一个数组或对象：只配对括号、跳过字符串，不检查其中的内容
+static int lept_skip_container(lept_context* c) {
+    return lept_match_brackets(&c->json, c->end);
+}
+
+// 懒惰模式：容器只记录它在输入中的范围（借用 u.s），访问时由 lept_materialize 解析
+static int lept_parse_lazy_container(lept_context* c, lept_value* v, lept_type type) {
+    const char* p = c->json;
+    int ret;
+    if ((ret = lept_skip_container(c)) != LEPT_PARSE_OK)
+        return ret;
+    if (!LEPT_SIZE_FITS(c->json - p))  // 范围记录在 u.s.size 中
+        return LEPT_PARSE_TOO_LARGE;
+    v->type = type;
+    v->flags = LEPT_FLAG_LAZY;
+    v->u.s.str = (char*)p;
+    v->u.s.size = c->json - p;
+    return LEPT_PARSE_OK;
+}
+
+// 解析第一个非空字符
+static int lept_parse_value(lept_context* c, lept_value* v) {
+    if (c->json == c->end)
+        return LEPT_PARSE_EXPECT_VALUE;  // 纯空白行
+    switch (*c->json) {
+        case 't':   return lept_parse_literal(c, v, "true", LEPT_TRUE);
+        case 'f':   return lept_parse_literal(c, v, "false", LEPT_FALSE);
+        case 'n':   return lept_parse_literal(c, v, "null", LEPT_NULL);
+        case '"':   return lept_parse_string(c, v);
+        case '[':   return c->lazy ? lept_parse_lazy_container(c, v, LEPT_ARRAY) : lept_parse_array(c,v);
+        case '{':   return c->lazy ? lept_parse_lazy_container(c, v, LEPT_OBJECT) : lept_parse_object(c, v);
+        default:    return lepr_parse_number(c, v);
+    }
+}
+
+// 解析的三个部分：空白、值、空白
+static int lept_parse_context(lept_context* c, lept_value* v) {
+    lept_parse_whitespace(c);           // 处理第一部分
+    int nRet = lept_parse_value(c, v);  // 处理第二部分
+    if ( LEPT_PARSE_OK == nRet ) {      // 处理第三部分
+        lept_parse_whitespace(c);
+        if (c->json != c->end) {
+            lept_free(v);
+            nRet = LEPT_PARSE_ROOT_NOT_SINGULAR;
+        }
+    }
+    assert(c->top == 0);
+    free(c->stack);
+    return nRet;
+}
+
+int lept_parse(lept_value* v, const char* json) {
+    assert(json != NULL);
+    return lept_parse_n(v, json, strlen(json));
+}
+
+int lept_parse_n(lept_value* v, const char* json, size_t len) {
+    assert(v != NULL && (json != NULL || len == 0));
+    lept_init(v);
+    lept_context c;
+    lept_context_init(&c, json, len);
+    return lept_parse_context(&c, v);
+}
+
+int lept_parse_insitu(lept_value* v, char* json) {
+    assert(v != NULL && json != NULL);
+    lept_init(v);
+    lept_context c;
+    lept_context_init(&c, json, strlen(json));
+    c.insitu = 1;
+    return lept_parse_context(&c, v);
+}
+
+int lept_parse_arena(lept_value* v, const char* json, lept_arena* a) {
+    assert(v != NULL && json != NULL && a != NULL);
+    lept_init(v);
+    lept_context c;
+    lept_context_init(&c, json, strlen(json));
+    c.arena = a;
+    return lept_parse_context(&c, v);
+}
+
+int lept_skip_value(const char* json, size_t len, size_t* end) {
+    const char* p, *e = json + len;
+    int ret = LEPT_PARSE_OK;
+    assert((json != NULL || len == 0) && end != NULL);
+    p = lept_skip_whitespace(json, e);
+    if (p == e)
+        return LEPT_PARSE_EXPECT_VALUE;
+    switch (*p) {
+        case '[':
+        case '{':
+            ret = lept_match_brackets(&p, e);
+            break;
+        case '\"':
+            p++;
+            ret = lept_skip_string(&p, e);
+            break;
+        case ']':
+        case '}':
+        case ',':
+        case ':':
+            return LEPT_PARSE_INVALID_VALUE;
+        default:  // 字面量或数字：直到下一个分隔符
+            while (p < e && *p != ',' && *p != ']' && *p != '}' && *p != ':' && !ISWHITESPACE(*p))
+                p++;
+    }
+    if (ret == LEPT_PARSE_OK)
+        *end = p - json;
+    return ret;
+}
+
+// 校验字符串，*pp 指向开引号之后；成功时指向闭引号之后，失败时指向出错的字节（转义序列为它的反斜杠）
+static int lept_validate_string(const char** pp, const char* end) {
+    const char* p = *pp;
+    char buf[4];
+    size_t len;
+    int ret = LEPT_PARSE_OK;
+    while (1) {
+        p = lept_scan_string(p, end);
+        if (p == end) {
+            ret = LEPT_PARSE_MISS_QUOTATION_MARK;
+            break;
+        }
+        if (*p == '\"') {
+            p++;
+            break;
+        }
+        if (*p != '\\') {  // 只可能是控制字符
+            ret = LEPT_PARSE_INVALID_STRING_CHAR;
+            break;
+        }
+        p++;
+        if ((ret = lept_parse_escape(&p, end, buf, &len)) != LEPT_PARSE_OK) {
+            p--;
+            break;
+        }
+    }
+    *pp = p;
+    return ret;
+}
+
+// 完整地转换数字，只关心能否解析，结论与 lept_parse 相同
+static int lept_validate_number_exact(const char** pp, const char* end) {
+    lept_context c;  // 数字的解析只用到 json 和 end，不需要栈
+    lept_value e;
+    int ret;
+    c.json = *pp;
+    c.end = end;
+    if ((ret = lepr_parse_number(&c, &e)) == LEPT_PARSE_OK)
+        *pp = c.json;
+    return ret;
+}
+
+// 校验数字，失败时 *pp 不变。只检查语法，不转换；
+// 有指数部分或整数部分超过308位时可能超出double的范围，才完整地转换
+static int lept_validate_number(const char** pp, const char* end) {
+    const char* p = *pp, *digits;
+#define CH(p) ((p) < end ? *(p) : '\0')
+    if (CH(p) == '-')
+        p++;
+    digits = p;
+    if (CH(p) == '0')
+        p++;
+    else if (ISDIGIT1TO9(CH(p)))
+        for (p++; ISDIGIT(CH(p)); p++);
+    else
+        return LEPT_PARSE_INVALID_VALUE;
+    if (p - digits > 308)
+        return lept_validate_number_exact(pp, end);
+    if (CH(p) == '.') {
+        p++;
+        if (!ISDIGIT(CH(p)))
+            return LEPT_PARSE_INVALID_VALUE;
+        for (p++; ISDIGIT(CH(p)); p++);
+    }
+    if (CH(p) == 'e' || CH(p) == 'E')
+        return lept_validate_number_exact(pp, end);
+#undef CH
+    *pp = p;
+    return LEPT_PARSE_OK;
+}
+
+// 字面量：只比较前缀，之后的字节由调用者检查，与 lept_parse_literal 相同
+static int lept_validate_literal(const char** pp, const char* end, const char* literal, size_t len) {
+    if ((size_t)(end - *pp) < len || memcmp(*pp, literal, len) != 0)
+        return LEPT_PARSE_INVALID_VALUE;
+    *pp += len;
+    return LEPT_PARSE_OK;
+}
+
+// 对象的键和冒号，*pp 指向键应在的位置（之前的空白已跳过），成功时指向冒号之后的空白之后
+// 键本身有误时与 lept_parse_object 一样报告为缺少键，*pp 不变
+static int lept_validate_key(const char** pp, const char* end) {
+    const char* p = *pp;
+    if (p == end || *p++ != '\"' || lept_validate_string(&p, end) != LEPT_PARSE_OK)
+        return LEPT_PARSE_MISS_KEY;
+    p = lept_skip_whitespace(p, end);
+    *pp = p;
+    if (p == end || *p != ':')
+        return LEPT_PARSE_MISS_COLON;
+    p++;
+    p = lept_skip_whitespace(p, end);
+    *pp = p;
+    return LEPT_PARSE_OK;
+}
+
+// 校验一个值，*pp 指向值的开头（之前的空白已跳过），失败时指向出错的位置
+// 不递归下降：用位图记录每层容器是数组还是对象，超过 LEPT_VALIDATE_DEPTH 层时更深的容器递归校验
+static int lept_validate_value(const char** pp, const char* end) {
+    uint64_t objects[LEPT_VALIDATE_DEPTH / 64];  // 第 i 位为1表示第 i 层是对象
+    const char* p = *pp;
+    size_t depth = 0;
+    int ret = LEPT_PARSE_OK, object;
+    while (ret == LEPT_PARSE_OK) {
+        // 此处应有一个值
+        if (p == end) {
+            ret = LEPT_PARSE_EXPECT_VALUE;
+            break;
+        }
+        switch (*p) {
+            case 't':   ret = lept_validate_literal(&p, end, "true", 4); break;
+            case 'f':   ret = lept_validate_literal(&p, end, "false", 5); break;
+            case 'n':   ret = lept_validate_literal(&p, end, "null", 4); break;
+            case '\"':
+                p++;
+                ret = lept_validate_string(&p, end);
+                break;
+            case '[':
+            case '{':
+                if (depth == LEPT_VALIDATE_DEPTH) {
+                    ret = lept_validate_value(&p, end);
+                    break;
+                }
+                object = *p++ == '{';
+                if (object)
+                    objects[depth / 64] |= (uint64_t)1 << depth % 64;
+                else
+                    objects[depth / 64] &= ~((uint64_t)1 << depth % 64);
+                depth++;
+                p = lept_skip_whitespace(p, end);
+                if (p < end && *p == (object ? '}' : ']')) {  // 空容器
+                    p++;
+                    depth--;
+                    break;
+                }
+                if (object)
+                    ret = lept_validate_key(&p, end);
+                continue;  // 第一个元素
+            default:    ret = lept_validate_number(&p, end); break;
+        }
+        // 一个值结束：逐层处理右括号，遇到逗号时回到开头校验下一个值
+        while (ret == LEPT_PARSE_OK && depth) {
+            object = objects[(depth - 1) / 64] >> (depth - 1) % 64 & 1;
+            p = lept_skip_whitespace(p, end);
+            if (p < end && *p == ',') {
+                p++;
+                p = lept_skip_whitespace(p, end);
+                if (object)
+                    ret = lept_validate_key(&p, end);
+                break;
+            }
+            if (p < end && *p == (object ? '}' : ']')) {
+                p++;
+                depth--;
+            } else
+                ret = object ? LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET : LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET;
+        }
+        if (depth == 0)
+            break;
+    }
+    *pp = p;
+    return ret;
+}
+
+int lept_validate(const char* json, size_t len, size_t* err_offset) {
+    const char* p, *end = json + len;
+    int ret;
+    assert(json != NULL || len == 0);
+    p = lept_skip_whitespace(json, end);
+    if ((ret = lept_validate_value(&p, end)) == LEPT_PARSE_OK) {
+        p = lept_skip_whitespace(p, end);
+        if (p != end)
+            ret = LEPT_PARSE_ROOT_NOT_SINGULAR;
+    }
+    if (ret != LEPT_PARSE_OK && err_offset)
+        *err_offset = p - json;
+    return ret;
+}
+
+int lept_parse_lazy(lept_value* v, const char* json) {
+    const char* p, *q;
+    size_t len;
+    int ret;
+    assert(v != NULL && json != NULL);
+    lept_init(v);
+    len = strlen(json);
+    // 先校验整个文本（不建树）：容器展开时不会再出错，错误不会被访问接口吞掉
+    if ((ret = lept_validate(json, len, NULL)) != LEPT_PARSE_OK)
+        return ret;
+    // 文本合法，根容器就是去掉首尾空白的整个文本，不必再配对一遍括号
+    p = lept_skip_whitespace(json, json + len);
+    for (q = json + len; ISWHITESPACE(q[-1]); q--)
+        ;
+    if (*p == '[' || *p == '{') {
+        if (!LEPT_SIZE_FITS(q - p))
+            return LEPT_PARSE_TOO_LARGE;
+        v->type = *p == '[' ? LEPT_ARRAY : LEPT_OBJECT;
+        v->flags = LEPT_FLAG_LAZY;
+        v->u.s.str = (char*)p;
+        v->u.s.size = q - p;
+        return LEPT_PARSE_OK;
+    }
+    lept_context c;
+    lept_context_init(&c, json, len);
+    c.lazy = 1;
+    return lept_parse_context(&c, v);
+}
+
+int lept_materialize(lept_value* v) {
+    lept_context c;
+    lept_value t;
+    int ret;
+    assert(v != NULL);
+    if (!(v->flags & LEPT_FLAG_LAZY))
+        return LEPT_PARSE_OK;
+    lept_context_init(&c, v->u.s.str, v->u.s.size);
+    c.lazy = 1;  // 只展开这一层，子容器仍然懒惰
+    lept_init(&t);
+    ret = v->type == LEPT_ARRAY ? lept_parse_array(&c, &t) : lept_parse_object(&c, &t);
+    assert(c.top == 0);
+    free(c.stack);
+    if (ret != LEPT_PARSE_OK) {  // 输入在 lept_parse_lazy 之后被修改时才会出错，成为空容器
+        t.type = v->type;
+        t.u.a.e = NULL;
+        t.u.a.size = 0;
+        LEPT_SET_ARRAY_CAPACITY(&t, 0);
+    }
+    memcpy(v, &t, sizeof(lept_value));  // 懒惰的值不持有内存，直接覆盖
+    return ret;
+}
+
+int lept_parse_keypool(lept_value* v, const char* json, lept_keypool* p) {
+    assert(v != NULL && json != NULL && p != NULL);
+    lept_init(v);
+    lept_context c;
+    lept_context_init(&c, json, strlen(json));
+    c.keys = p;
+    return lept_parse_context(&c, v);
+}
+
+int lept_parse_projected(lept_value* v, const char* json, const char* const* paths, size_t npaths) {
+    lept_arena a;
+    lept_path_node root;
+    lept_context c;
+    int ret;
+    assert(v != NULL && json != NULL && (paths != NULL || npaths == 0));
+    lept_init(v);
+    for (size_t i = 0; i < npaths; i++)
+        if (!lept_path_valid(paths[i]))
+            return LEPT_PARSE_INVALID_PATH;
+    lept_arena_init(&a, 0);
+    memset(&root, 0, sizeof(root));
+    for (size_t i = 0; i < npaths; i++)
+        lept_path_insert(&a, &root, paths[i]);
+    lept_path_resolve(&a, &root);
+    lept_context_init(&c, json, strlen(json));
+    c.proj = root.leaf ? NULL : &root;
+    ret = lept_parse_context(&c, v);
+    lept_arena_free(&a);
+    return ret;
+}
+
+// 调用事件回调：回调为NULL时忽略该事件，回调返回FALSE时中止解析
+#define SAX_CALL(c, f, args) (!(c)->handler->f || (c)->handler->f args ? LEPT_PARSE_OK : LEPT_PARSE_TERMINATED)
+
+static int lept_sax_parse_value(lept_context* c);
+
+// 整数优先交给int64/uint64回调，没有提供时转换为double
+static int lept_sax_number(lept_context* c, const lept_value* e) {
+    if ((e->flags & LEPT_FLAG_INT64) && c->handler->int64)
+        return SAX_CALL(c, int64, (c->user, e->u.i));
+    if ((e->flags & LEPT_FLAG_UINT64) && c->handler->uint64)
+        return SAX_CALL(c, uint64, (c->user, e->u.u));
+    return SAX_CALL(c, number, (c->user, lept_get_number(e)));
+}
+
+// 字符串解码到栈上后直接交给回调，回调期间字符串以'\0'结尾，之后即被弹出
+static int lept_sax_parse_string(lept_context* c, int is_key) {
+    size_t len;
+    int ret;
+    if ((ret = lept_parse_string_stack(c, &len)) != LEPT_PARSE_OK)
+        return ret;
+    lept_context_push(c, '\0');
+    const char* s = lept_context_pop(c, len + 1);
+    return is_key ? SAX_CALL(c, key, (c->user, s, len)) : SAX_CALL(c, string, (c->user, s, len));
+}
+
+static int lept_sax_parse_array(lept_context* c) {
+    size_t size = 0;
+    int ret;
+    EXPECT(c, '[');
+    if ((ret = SAX_CALL(c, start_array, (c->user))) != LEPT_PARSE_OK)
+        return ret;
+    lept_parse_whitespace(c);
+    if (PEEK(c) == ']') {
+        c->json++;
+        return SAX_CALL(c, end_array, (c->user, 0));
+    }
+    while (1) {
+        if ((ret = lept_sax_parse_value(c)) != LEPT_PARSE_OK)
+            return ret;
+        size++;
+        lept_parse_whitespace(c);
+        if (PEEK(c) == ',') {
+            c->json++;
+            lept_parse_whitespace(c);
+        } else if (PEEK(c) == ']') {
+            c->json++;
+            return SAX_CALL(c, end_array, (c->user, size));
+        } else
+            return LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET;
+    }
+}
+
+static int lept_sax_parse_object(lept_context* c) {
+    size_t size = 0;
+    int ret;
+    EXPECT(c, '{');
+    if ((ret = SAX_CALL(c, start_object, (c->user))) != LEPT_PARSE_OK)
+        return ret;
+    lept_parse_whitespace(c);
+    if (PEEK(c) == '}') {
+        c->json++;
+        return SAX_CALL(c, end_object, (c->user, 0));
+    }
+    while (1) {
+        if (PEEK(c) != '\"')
+            return LEPT_PARSE_MISS_KEY;
+        if ((ret = lept_sax_parse_string(c, TRUE)) != LEPT_PARSE_OK)
+            return ret == LEPT_PARSE_TERMINATED ? ret : LEPT_PARSE_MISS_KEY;
+        lept_parse_whitespace(c);
+        if (PEEK(c) != ':')
+            return LEPT_PARSE_MISS_COLON;
+        c->json++;
+        lept_parse_whitespace(c);
+        if ((ret = lept_sax_parse_value(c)) != LEPT_PARSE_OK)
+            return ret;
+        size++;
+        lept_parse_whitespace(c);
+        if (PEEK(c) == ',') {
+            c->json++;
+            lept_parse_whitespace(c);
+        } else if (PEEK(c) == '}') {
+            c->json++;
+            return SAX_CALL(c, end_object, (c->user, size));
+        } else
+            return LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET;
+    }
+}
+
+// 与lept_parse_value共用字面值和数字的解析，结果不落到树上而是通过回调交出
+static int lept_sax_parse_value(lept_context* c) {
+    lept_value e;
+    int ret;
+    lept_init(&e);
+    if (c->json == c->end)
+        return LEPT_PARSE_EXPECT_VALUE;
+    switch (*c->json) {
+        case 't':   ret = lept_parse_literal(c, &e, "true", LEPT_TRUE); break;
+        case 'f':   ret = lept_parse_literal(c, &e, "false", LEPT_FALSE); break;
+        case 'n':   ret = lept_parse_literal(c, &e, "null", LEPT_NULL); break;
+        case '"':   return lept_sax_parse_string(c, FALSE);
+        case '[':   return lept_sax_parse_array(c);
+        case '{':   return lept_sax_parse_object(c);
+        default:    ret = lepr_parse_number(c, &e); break;
+    }
+    if (ret != LEPT_PARSE_OK)
+        return ret;
+    switch (e.type) {
+        case LEPT_NULL:   return SAX_CALL(c, null, (c->user));
+        case LEPT_FALSE:  return SAX_CALL(c, boolean, (c->user, FALSE));
+        case LEPT_TRUE:   return SAX_CALL(c, boolean, (c->user, TRUE));
+        default:          return lept_sax_number(c, &e);
+    }
+}
+
+int lept_parse_sax(const char* json, size_t len, const lept_handler* handler, void* user) {
+    lept_context c;
+    int ret;
+    assert((json != NULL || len == 0) && handler != NULL);
+    lept_context_init(&c, json, len);
+    c.handler = handler;
+    c.user = user;
+    lept_parse_whitespace(&c);
+    if ((ret = lept_sax_parse_value(&c)) == LEPT_PARSE_OK) {
+        lept_parse_whitespace(&c);
+        if (c.json != c.end)
+            ret = LEPT_PARSE_ROOT_NOT_SINGULAR;
+    }
+    free(c.stack);
+    return ret;
+}
+
+/* 建树回调：把事件还原成lept_value，供增量解析器在没有用户回调时使用
+ * 栈上每一项都是一个lept_member：键事件压入 {k, 空值}，值事件压入 {NULL, v}，
+ * 容器结束时按元素个数弹出，对象的每个成员对应"键项+值项"两项 */
+static int lept_dom_push(void* user, const char* k, size_t klen, const lept_value* v) {
+    lept_member* m = (lept_member*)lept_context_push_len((lept_context*)user, sizeof(lept_member));
+    m->k = NULL;
+    m->klen = klen;
+    if (k) {
+        memcpy(m->k = (char*)malloc(klen + 1), k, klen);
+        m->k[klen] = '\0';
+    }
+    memcpy(&m->v, v, sizeof(lept_value));
+    return TRUE;
+}
+
+static int lept_dom_null(void* user) {
+    lept_value v;
+    lept_init(&v);
+    return lept_dom_push(user, NULL, 0, &v);
+}
+
+static int lept_dom_boolean(void* user, int b) {
+    lept_value v;
+    lept_init(&v);
+    v.type = b ? LEPT_TRUE : LEPT_FALSE;
+    return lept_dom_push(user, NULL, 0, &v);
+}
+
+static int lept_dom_number(void* user, double n) {
+    lept_value v;
+    lept_init(&v);
+    lept_set_number(&v, n);
+    return lept_dom_push(user, NULL, 0, &v);
+}
+
+static int lept_dom_int64(void* user, int64_t i) {
+    lept_value v;
+    lept_init(&v);
+    lept_set_int64(&v, i);
+    return lept_dom_push(user, NULL, 0, &v);
+}
+
+static int lept_dom_uint64(void* user, uint64_t u) {
+    lept_value v;
+    lept_init(&v);
+    lept_set_uint64(&v, u);
+    return lept_dom_push(user, NULL, 0, &v);
+}
+
+static int lept_dom_string(void* user, const char* s, size_t len) {
+    lept_value v;
+    lept_init(&v);
+    lept_set_string(&v, s, len);
+    return lept_dom_push(user, NULL, 0, &v);
+}
+
+static int lept_dom_key(void* user, const char* s, size_t len) {
+    lept_value v;
+    lept_init(&v);
+    return lept_dom_push(user, s, len, &v);
+}
+
+static int lept_dom_start(void* user) {
+    (void)user;
+    return TRUE;
+}
+
+static int lept_dom_end_array(void* user, size_t count) {
+    lept_context* d = (lept_context*)user;
+    lept_member* m = (lept_member*)lept_context_pop(d, count * sizeof(lept_member));
+    lept_value v;
+    size_t i = 0;
+    lept_init(&v);
+    if (count >= LEPT_PACKED_ARRAY_THRESHOLD)
+        while (i < count && lept_number_packable(&m[i].v))
+            i++;
+    if (count >= LEPT_PACKED_ARRAY_THRESHOLD && i == count) {  // 与lept_parse一致，纯数字数组存为double
+        double* n = (double*)lept_heap_realloc(NULL, count * sizeof(double));
+        for (i = 0; i < count; i++)
+            n[i] = lept_get_number(&m[i].v);
+        v.type = LEPT_ARRAY;
+        v.flags = LEPT_FLAG_PACKED;
+        v.u.a.e = (lept_value*)n;
+        v.u.a.size = count;
+        LEPT_SET_ARRAY_CAPACITY(&v, count);
+        return lept_dom_push(user, NULL, 0, &v);
+    }
+    lept_set_array(&v, count);
+    for (i = 0; i < count; i++)
+        memcpy(&v.u.a.e[i], &m[i].v, sizeof(lept_value));
+    v.u.a.size = count;
+    return lept_dom_push(user, NULL, 0, &v);
+}
+
+static int lept_dom_end_object(void* user, size_t count) {
+    lept_context* d = (lept_context*)user;
+    lept_member* m = (lept_member*)lept_context_pop(d, 2 * count * sizeof(lept_member));
+    lept_value v;
+    lept_init(&v);
+    lept_set_object(&v, count);
+    for (size_t i = 0; i < count; i++) {
+        v.u.o.m[i].k = m[2 * i].k;
+        v.u.o.m[i].klen = m[2 * i].klen;
+        memcpy(&v.u.o.m[i].v, &m[2 * i + 1].v, sizeof(lept_value));
+    }
+    v.u.o.size = count;
+    if (count >= LEPT_OBJECT_HASH_THRESHOLD)
+        lept_object_hash(&v);
+    return lept_dom_push(user, NULL, 0, &v);
+}
+
+static const lept_handler lept_dom_handler = {
+    lept_dom_null, lept_dom_boolean, lept_dom_number, lept_dom_string, lept_dom_key,
+    lept_dom_start, lept_dom_end_array, lept_dom_start, lept_dom_end_object,
+    lept_dom_int64, lept_dom_uint64
+};
+
+/* 增量解析器的状态 */
+enum {
+    LEPT_STREAM_VALUE,          // 期待一个值
+    LEPT_STREAM_ARRAY_FIRST,    // '[' 之后：值或 ']'
+    LEPT_STREAM_OBJECT_FIRST,   // '{' 之后：键或 '}'
+    LEPT_STREAM_KEY,            // 对象中 ',' 之后：键
+    LEPT_STREAM_COLON,          // 键之后：':'
+    LEPT_STREAM_AFTER_VALUE,    // 容器中的值之后：',' 或右括号
+    LEPT_STREAM_DONE,           // 根值已结束，只允许空白
+    LEPT_STREAM_STRING,         // 字符串内部
+    LEPT_STREAM_ESCAPE,         // 字符串中 '\\' 之后
+    LEPT_STREAM_HEX,            // \u 之后的 4 位十六进制
+    LEPT_STREAM_LOW_BACKSLASH,  // 高代理项之后，期待 '\\'
+    LEPT_STREAM_LOW_U,          // 期待低代理项的 'u'
+    LEPT_STREAM_LOW_HEX,        // 低代理项的 4 位十六进制
+    LEPT_STREAM_LITERAL,        // true/false/null 内部
+    LEPT_STREAM_NUMBER          // 数字内部
+};
+
+/* c.stack 上的容器帧，未完成的字符串/数字压在最内层的帧之上 */
+typedef struct {
+    size_t count;   // 已完成的元素/成员个数
+    lept_type type; // LEPT_ARRAY 或 LEPT_OBJECT
+} lept_stream_frame;
+
+#define ISNUMBERCHAR(ch)    (ISDIGIT(ch) || (ch) == '-' || (ch) == '+' || (ch) == '.' || (ch) == 'e' || (ch) == 'E')
+#define STREAM_ERROR(e)     do { ps->ret = (e); return ps->ret; } while (0)
+#define STREAM_FRAME(ps)    ((lept_stream_frame*)((ps)->c.stack + (ps)->c.top) - 1)
+
+void lept_stream_init(lept_stream* ps, const lept_handler* handler, void* user) {
+    assert(ps != NULL);
+    lept_context_init(&ps->c, "", 0);
+    ps->dom.stack = NULL;
+    ps->dom.top = 0;
+    if (handler) {
+        ps->c.handler = handler;
+        ps->c.user = user;
+    } else {  // 没有回调时建树
+        lept_context_init(&ps->dom, "", 0);
+        ps->c.handler = &lept_dom_handler;
+        ps->c.user = &ps->dom;
+    }
+    ps->state = LEPT_STREAM_VALUE;
+    ps->ret = LEPT_PARSE_OK;
+    ps->depth = 0;
+}
+
+void lept_stream_free(lept_stream* ps) {
+    assert(ps != NULL);
+    while (ps->dom.top) {  // 出错或中途放弃时，释放暂存的值
+        lept_member* m = (lept_member*)lept_context_pop(&ps->dom, sizeof(lept_member));
+        free(m->k);
+        lept_free(&m->v);
+    }
+    free(ps->dom.stack);
+    free(ps->c.stack);
+    ps->dom.stack = ps->c.stack = NULL;
+}
+
+// 一个值结束：根值结束后只允许空白，否则计入所在容器
+static void lept_stream_value_done(lept_stream* ps) {
+    if (ps->depth == 0)
+        ps->state = LEPT_STREAM_DONE;
+    else {
+        STREAM_FRAME(ps)->count++;
+        ps->state = LEPT_STREAM_AFTER_VALUE;
+    }
+}
+
+static int lept_stream_open(lept_stream* ps, lept_type type) {
+    lept_stream_frame* f = (lept_stream_frame*)lept_context_push_len(&ps->c, sizeof(lept_stream_frame));
+    f->count = 0;
+    f->type = type;
+    ps->depth++;
+    if (type == LEPT_ARRAY) {
+        ps->state = LEPT_STREAM_ARRAY_FIRST;
+        return SAX_CALL(&ps->c, start_array, (ps->c.user));
+    }
+    ps->state = LEPT_STREAM_OBJECT_FIRST;
+    return SAX_CALL(&ps->c, start_object, (ps->c.user));
+}
+
+static int lept_stream_close(lept_stream* ps) {
+    lept_stream_frame f;
+    int ret;
+    if (ps->c.handler == &lept_dom_handler && !LEPT_SIZE_FITS(STREAM_FRAME(ps)->count))  // 建树时与lept_parse一样受长度上限约束
+        return LEPT_PARSE_TOO_LARGE;
+    f = *(lept_stream_frame*)lept_context_pop(&ps->c, sizeof(lept_stream_frame));
+    ps->depth--;
+    if (f.type == LEPT_ARRAY)
+        ret = SAX_CALL(&ps->c, end_array, (ps->c.user, f.count));
+    else
+        ret = SAX_CALL(&ps->c, end_object, (ps->c.user, f.count));
+    lept_stream_value_done(ps);
+    return ret;
+}
+
+// 字符串结束：栈顶的字节交给回调后弹出
+static int lept_stream_string_done(lept_stream* ps) {
+    lept_context* c = &ps->c;
+    size_t len = c->top - ps->head;
+    int ret;
+    lept_context_push(c, '\0');
+    const char* s = c->stack + ps->head;
+    c->top = ps->head;  // 回调期间不再压栈，s 保持有效
+    if (ps->is_key) {
+        ps->state = LEPT_STREAM_COLON;
+        return SAX_CALL(c, key, (c->user, s, len));
+    }
+    if (c->handler == &lept_dom_handler && !LEPT_SIZE_FITS(len))
+        return LEPT_PARSE_TOO_LARGE;
+    ret = SAX_CALL(c, string, (c->user, s, len));
+    lept_stream_value_done(ps);
+    return ret;
+}
+
+// 数字结束：用lepr_parse_number解析栈顶累积的字节
+static int lept_stream_number_done(lept_stream* ps) {
+    lept_context* c = &ps->c;
+    size_t len = c->top - ps->head;
+    const char* json = c->json, *end = c->end;
+    lept_value e;
+    int ret;
+    c->json = c->stack + ps->head;
+    c->end = c->json + len;
+    ret = lepr_parse_number(c, &e);
+    len = c->end - c->json;  // 未被数字文法接受的剩余字节
+    c->json = json;
+    c->end = end;
+    c->top = ps->head;
+    if (ret != LEPT_PARSE_OK)
+        return ret;
+    if ((ret = lept_sax_number(c, &e)) != LEPT_PARSE_OK)
+        return ret;
+    lept_stream_value_done(ps);
+    if (len)  // 剩余字节不可能是空白或分隔符，与lept_parse报同样的错误
+        return ps->depth == 0 ? LEPT_PARSE_ROOT_NOT_SINGULAR :
+            STREAM_FRAME(ps)->type == LEPT_ARRAY ? LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET : LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET;
+    return LEPT_PARSE_OK;
+}
+
+// 键中的任何错误都按lept_parse的约定报告为缺少键
+#define STREAM_STRING_ERROR(e) STREAM_ERROR(ps->is_key ? LEPT_PARSE_MISS_KEY : (e))
+
+int lept_stream_feed(lept_stream* ps, const char* chunk, size_t len) {
+    lept_context* c = &ps->c;
+    const char* p = chunk, *end = chunk + len, *q;
+    char buf[4];
+    size_t n;
+    int ret;
+    assert(ps != NULL && (chunk != NULL || len == 0));
+    if (ps->ret != LEPT_PARSE_OK)
+        return ps->ret;
+    while (p < end) {
+        char ch = *p;
+        switch (ps->state) {
+            case LEPT_STREAM_VALUE:
+                if (ISWHITESPACE(ch))
+                    break;
+                switch (ch) {
+                    case '"':
+                        ps->state = LEPT_STREAM_STRING;
+                        ps->is_key = FALSE;
+                        ps->head = c->top;
+                        break;
+                    case '[':
+                    case '{':
+                        if ((ret = lept_stream_open(ps, ch == '[' ? LEPT_ARRAY : LEPT_OBJECT)) != LEPT_PARSE_OK)
+                            STREAM_ERROR(ret);
+                        break;
+                    case 't': ps->literal = "true";  ps->matched = 1; ps->state = LEPT_STREAM_LITERAL; break;
+                    case 'f': ps->literal = "false"; ps->matched = 1; ps->state = LEPT_STREAM_LITERAL; break;
+                    case 'n': ps->literal = "null";  ps->matched = 1; ps->state = LEPT_STREAM_LITERAL; break;
+                    default:
+                        if (ch != '-' && !ISDIGIT(ch))
+                            STREAM_ERROR(LEPT_PARSE_INVALID_VALUE);
+                        ps->state = LEPT_STREAM_NUMBER;
+                        ps->head = c->top;
+                        lept_context_push(c, ch);
+                }
+                break;
+            case LEPT_STREAM_ARRAY_FIRST:
+                if (ISWHITESPACE(ch))
+                    break;
+                if (ch == ']') {
+                    if ((ret = lept_stream_close(ps)) != LEPT_PARSE_OK)
+                        STREAM_ERROR(ret);
+                    break;
+                }
+                ps->state = LEPT_STREAM_VALUE;
+                continue;  // 当前字符作为值重新处理
+            case LEPT_STREAM_OBJECT_FIRST:
+            case LEPT_STREAM_KEY:
+                if (ISWHITESPACE(ch))
+                    break;
+                if (ch == '}' && ps->state == LEPT_STREAM_OBJECT_FIRST) {
+                    if ((ret = lept_stream_close(ps)) != LEPT_PARSE_OK)
+                        STREAM_ERROR(ret);
+                    break;
+                }
+                if (ch != '"')
+                    STREAM_ERROR(LEPT_PARSE_MISS_KEY);
+                ps->state = LEPT_STREAM_STRING;
+                ps->is_key = TRUE;
+                ps->head = c->top;
+                break;
+            case LEPT_STREAM_COLON:
+                if (ISWHITESPACE(ch))
+                    break;
+                if (ch != ':')
+                    STREAM_ERROR(LEPT_PARSE_MISS_COLON);
+                ps->state = LEPT_STREAM_VALUE;
+                break;
+            case LEPT_STREAM_AFTER_VALUE:
+                if (ISWHITESPACE(ch))
+                    break;
+                if (STREAM_FRAME(ps)->type == LEPT_ARRAY) {
+                    if (ch == ',')
+                        ps->state = LEPT_STREAM_VALUE;
+                    else if (ch == ']') {
+                        if ((ret = lept_stream_close(ps)) != LEPT_PARSE_OK)
+                            STREAM_ERROR(ret);
+                    } else
+                        STREAM_ERROR(LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET);
+                } else {
+                    if (ch == ',')
+                        ps->state = LEPT_STREAM_KEY;
+                    else if (ch == '}') {
+                        if ((ret = lept_stream_close(ps)) != LEPT_PARSE_OK)
+                            STREAM_ERROR(ret);
+                    } else
+                        STREAM_ERROR(LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET);
+                }
+                break;
+            case LEPT_STREAM_DONE:
+                if (!ISWHITESPACE(ch))
+                    STREAM_ERROR(LEPT_PARSE_ROOT_NOT_SINGULAR);
+                break;
+            case LEPT_STREAM_STRING:
+                // 不需要转义的一段字节整体压栈
+                q = lept_scan_string(p, end);
+                PUTS(c, p, q - p);
+                if ((p = q) == end)
+                    continue;
+                if (*p == '"') {
+                    if ((ret = lept_stream_string_done(ps)) != LEPT_PARSE_OK)
+                        STREAM_ERROR(ret);
+                } else if (*p == '\\')
+                    ps->state = LEPT_STREAM_ESCAPE;
+                else
+                    STREAM_STRING_ERROR(LEPT_PARSE_INVALID_STRING_CHAR);
+                break;
+            case LEPT_STREAM_ESCAPE:
+                if (ch == 'u') {
+                    ps->u = ps->hex = 0;
+                    ps->state = LEPT_STREAM_HEX;
+                    break;
+                }
+                q = p;
+                if ((ret = lept_parse_escape(&q, end, buf, &n)) != LEPT_PARSE_OK)
+                    STREAM_STRING_ERROR(ret);
+                lept_context_push(c, buf[0]);
+                ps->state = LEPT_STREAM_STRING;
+                break;
+            case LEPT_STREAM_HEX:
+            case LEPT_STREAM_LOW_HEX:
+                if (!ISHEXDIGIT(ch))
+                    STREAM_STRING_ERROR(ps->state == LEPT_STREAM_HEX ? LEPT_PARSE_INVALID_UNICODE_HEX : LEPT_PARSE_INVALID_UNICODE_SURROGATE);
+                ps->u = (ps->u << 4) | (unsigned)((ch >= 'a') ? (ch - 'a' + 10) : ((ch >= 'A') ? (ch - 'A' + 10) : (ch - '0')));
+                if (++ps->hex < 4)
+                    break;
+                if (ps->state == LEPT_STREAM_HEX && ps->u >= 0xD800 && ps->u <= 0xDBFF) {
+                    ps->hi = ps->u;
+                    ps->state = LEPT_STREAM_LOW_BACKSLASH;
+                    break;
+                }
+                if (ps->state == LEPT_STREAM_LOW_HEX) {
+                    if (ps->u < 0xDC00 || ps->u > 0xDFFF)
+                        STREAM_STRING_ERROR(LEPT_PARSE_INVALID_UNICODE_SURROGATE);
+                    ps->u = 0x10000 + (ps->hi - 0xD800) * 0x400 + (ps->u - 0xDC00);
+                }
+                PUTS(c, buf, lept_encode_utf8(buf, ps->u));
+                ps->state = LEPT_STREAM_STRING;
+                break;
+            case LEPT_STREAM_LOW_BACKSLASH:
+                if (ch != '\\')
+                    STREAM_STRING_ERROR(LEPT_PARSE_INVALID_UNICODE_SURROGATE);
+                ps->state = LEPT_STREAM_LOW_U;
+                break;
+            case LEPT_STREAM_LOW_U:
+                if (ch != 'u')
+                    STREAM_STRING_ERROR(LEPT_PARSE_INVALID_UNICODE_SURROGATE);
+                ps->u = ps->hex = 0;
+                ps->state = LEPT_STREAM_LOW_HEX;
+                break;
+            case LEPT_STREAM_LITERAL:
+                if (ch != ps->literal[ps->matched])
+                    STREAM_ERROR(LEPT_PARSE_INVALID_VALUE);
+                if (ps->literal[++ps->matched] == '\0') {
+                    switch (ps->literal[0]) {
+                        case 't': ret = SAX_CALL(c, boolean, (c->user, TRUE)); break;
+                        case 'f': ret = SAX_CALL(c, boolean, (c->user, FALSE)); break;
+                        default:  ret = SAX_CALL(c, null, (c->user)); break;
+                    }
+                    if (ret != LEPT_PARSE_OK)
+                        STREAM_ERROR(ret);
+                    lept_stream_value_done(ps);
+                }
+                break;
+            case LEPT_STREAM_NUMBER:
+                if (ISNUMBERCHAR(ch)) {
+                    lept_context_push(c, ch);
+                    break;
+                }
+                if ((ret = lept_stream_number_done(ps)) != LEPT_PARSE_OK)
+                    STREAM_ERROR(ret);
+                continue;  // 当前字符属于数字之后的部分
+        }
+        p++;
+    }
+    return LEPT_PARSE_OK;
+}
+
+int lept_stream_finish(lept_stream* ps, lept_value* v) {
+    int ret = LEPT_PARSE_OK;
+    assert(ps != NULL);
+    if (v)
+        lept_init(v);
+    if (ps->ret != LEPT_PARSE_OK)
+        return ps->ret;
+    if (ps->state == LEPT_STREAM_NUMBER && (ret = lept_stream_number_done(ps)) != LEPT_PARSE_OK)
+        STREAM_ERROR(ret);
+    // 在输入末尾停下的位置决定错误码，与lept_parse在同一位置遇到末尾时一致
+    switch (ps->state) {
+        case LEPT_STREAM_DONE:          break;
+        case LEPT_STREAM_VALUE:
+        case LEPT_STREAM_ARRAY_FIRST:   ret = LEPT_PARSE_EXPECT_VALUE; break;
+        case LEPT_STREAM_OBJECT_FIRST:
+        case LEPT_STREAM_KEY:           ret = LEPT_PARSE_MISS_KEY; break;
+        case LEPT_STREAM_COLON:         ret = LEPT_PARSE_MISS_COLON; break;
+        case LEPT_STREAM_AFTER_VALUE:
+            ret = STREAM_FRAME(ps)->type == LEPT_ARRAY ? LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET : LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET;
+            break;
+        case LEPT_STREAM_STRING:        ret = LEPT_PARSE_MISS_QUOTATION_MARK; break;
+        case LEPT_STREAM_ESCAPE:        ret = LEPT_PARSE_INVALID_STRING_ESCAPE; break;
+        case LEPT_STREAM_HEX:           ret = LEPT_PARSE_INVALID_UNICODE_HEX; break;
+        case LEPT_STREAM_LITERAL:       ret = LEPT_PARSE_INVALID_VALUE; break;
+        default:                        ret = LEPT_PARSE_INVALID_UNICODE_SURROGATE; break;
+    }
+    if (ret != LEPT_PARSE_OK) {
+        if (ps->state >= LEPT_STREAM_STRING && ps->state <= LEPT_STREAM_LOW_HEX)
+            STREAM_STRING_ERROR(ret);
+        STREAM_ERROR(ret);
+    }
+    if (v && ps->c.handler == &lept_dom_handler) {
+        lept_member* m = (lept_member*)lept_context_pop(&ps->dom, sizeof(lept_member));
+        memcpy(v, &m->v, sizeof(lept_value));
     }
+    return LEPT_PARSE_OK;
 }
 
-int lept_parse(lept_value* v, const char* json) {
-    assert(v != NULL);
-    lept_init(v);
-    lept_context c;
-    lept_context_init(&c, json);
-    lept_parse_whitespace(&c);           // 处理第一部分
-    int nRet = lept_parse_value(&c, v);  // 处理第二部分
-    if ( LEPT_PARSE_OK == nRet ) {       // 处理第三部分
-        lept_parse_whitespace(&c);
-        if (*c.json != '\0') {
-            v->type = LEPT_NULL;
-            nRet = LEPT_PARSE_ROOT_NOT_SINGULAR;
-        }
-    }
-    assert(c.top == 0);
-    free(c.stack);
-    return nRet;
+// 释放成员的键，借用的键不释放
+static void lept_free_key(const lept_value* v, lept_member* m) {
+    if (!(v->flags & LEPT_FLAG_KEYS_BORROWED))
+        free(m->k);
 }
 
 void lept_free(lept_value* v) {
     assert(v != NULL);
-    if (v->type == LEPT_STRING)
-        free(v->u.s.str);
-    else if (v->type == LEPT_ARRAY) {
+    if (v->flags & LEPT_FLAG_LAZY)
+        ;  // 未展开的容器只引用输入
+    else if (v->type == LEPT_STRING) {
+        if (!(v->flags & (LEPT_FLAG_BORROWED | LEPT_FLAG_SHORT)))
+            free(v->u.s.str);
+    } else if (v->type == LEPT_ARRAY) {
         // 释放每一个lept_value内部分配的内存
-        for (size_t i = 0; i < v->u.a.size; i++)
-            lept_free(&v->u.a.e[i]);
-        free(v->u.a.e);
+        if (!(v->flags & LEPT_FLAG_PACKED))
+            for (size_t i = 0; i < v->u.a.size; i++)
+                lept_free(&v->u.a.e[i]);
+        if (!(v->flags & LEPT_FLAG_BORROWED))
+            lept_heap_free(v->u.a.e);
     } else if (v->type == LEPT_OBJECT) {
         for (size_t i = 0; i < v->u.o.size; i++) {
-            free(v->u.o.m[i].k);
+            lept_free_key(v, &v->u.o.m[i]);
             lept_free(&v->u.o.m[i].v);
         }
-        free(v->u.o.m);
+        if (!(v->flags & LEPT_FLAG_BORROWED))
+            lept_heap_free(v->u.o.m);
     }
     v->type = LEPT_NULL;
+    v->flags = 0;
 }
 
 lept_type lept_get_type(const lept_value* v) {
@@ -465,6 +3104,10 @@ void lept_set_boolean(lept_value* v, int b) {
 
 double lept_get_number(const lept_value* v) {
     assert(v != NULL && v->type == LEPT_NUMBER);
+    if (v->flags & LEPT_FLAG_INT64)
+        return (double)v->u.i;
+    if (v->flags & LEPT_FLAG_UINT64)
+        return (double)v->u.u;
     return v->u.n;
 }
 
@@ -475,9 +3118,57 @@ void lept_set_number(lept_value* v, double n) {
     v->type = LEPT_NUMBER;
 }
 
+int lept_is_int64(const lept_value* v) {
+    assert(v != NULL);
+    return v->type == LEPT_NUMBER && (v->flags & LEPT_FLAG_INT64);
+}
+
+int lept_is_uint64(const lept_value* v) {
+    assert(v != NULL);
+    return v->type == LEPT_NUMBER && (v->flags & LEPT_FLAG_UINT64);
+}
+
+int64_t lept_get_int64(const lept_value* v) {
+    assert(v != NULL && v->type == LEPT_NUMBER);
+    if (v->flags & LEPT_FLAG_INT64)
+        return v->u.i;
+    if (v->flags & LEPT_FLAG_UINT64)
+        return (int64_t)v->u.u;
+    return (int64_t)v->u.n;
+}
+
+uint64_t lept_get_uint64(const lept_value* v) {
+    assert(v != NULL && v->type == LEPT_NUMBER);
+    if (v->flags & LEPT_FLAG_INT64)
+        return (uint64_t)v->u.i;
+    if (v->flags & LEPT_FLAG_UINT64)
+        return v->u.u;
+    return (uint64_t)v->u.n;
+}
+
+void lept_set_int64(lept_value* v, int64_t i) {
+    assert(v != NULL);
+    lept_free(v);
+    v->u.i = i;
+    v->type = LEPT_NUMBER;
+    v->flags = LEPT_FLAG_INT64;
+}
+
+void lept_set_uint64(lept_value* v, uint64_t u) {
+    assert(v != NULL);
+    lept_free(v);
+    v->u.u = u;
+    v->type = LEPT_NUMBER;
+    v->flags = LEPT_FLAG_UINT64;
+}
+
 void lept_set_string(lept_value* v, const char* s, size_t len) {
-    assert(v != NULL && (s != NULL || len == 0));
+    assert(v != NULL && (s != NULL || len == 0) && (lept_size)len == len);
     lept_free(v);
+    if (len <= LEPT_SHORT_STRING_MAX) {
+        lept_set_short_string(v, s, len);
+        return;
+    }
     v->u.s.str = (char*)malloc(len + 1);
     memcpy(v->u.s.str, s, len);
     v->u.s.str[len] = '\0';
@@ -487,25 +3178,133 @@ void lept_set_string(lept_value* v, const char* s, size_t len) {
 
 const char* lept_get_string(const lept_value* v) {
     assert(v != NULL && v->type == LEPT_STRING);
-    return v->u.s.str;
+    return v->flags & LEPT_FLAG_SHORT ? v->u.ss.str : v->u.s.str;
 }
 
 size_t lept_get_string_length(const lept_value* v) {
     assert(v != NULL && v->type == LEPT_STRING);
-    return v->u.s.size;
+    return v->flags & LEPT_FLAG_SHORT ? v->u.ss.size : v->u.s.size;
 }
 
 size_t lept_get_array_size(const lept_value* v) {
     assert(v != NULL && v->type == LEPT_ARRAY);
+    LEPT_MATERIALIZE(v);
     return v->u.a.size;
 }
 
+// 紧凑数组中的数字展开为值：2^53以内的整数值（-0除外）还原为 LEPT_FLAG_INT64，与解析整数字面量的结果一致
+static void lept_unpack_number(lept_value* e, double d) {
+    e->type = LEPT_NUMBER;
+    if (d >= -9007199254740992.0 && d <= 9007199254740992.0 && d == (double)(int64_t)d && !(d == 0.0 && signbit(d))) {
+        e->flags = LEPT_FLAG_INT64;
+        e->u.i = (int64_t)d;
+    } else {
+        e->flags = 0;
+        e->u.n = d;
+    }
+}
+
+// 紧凑的数字数组转换回一般数组，容量不变
+static void lept_unpack_array(lept_value* v) {
+    const double* n = LEPT_PACKED(v);
+    size_t capacity = LEPT_ARRAY_CAPACITY(v);
+    lept_value* e = capacity > 0 ? (lept_value*)lept_heap_realloc(NULL, capacity * sizeof(lept_value)) : NULL;
+    for (size_t i = 0; i < v->u.a.size; i++)
+        lept_unpack_number(&e[i], n[i]);
+    if (!(v->flags & LEPT_FLAG_BORROWED))
+        lept_heap_free(LEPT_PACKED(v));
+    v->flags = 0;
+    v->u.a.e = e;
+    LEPT_SET_ARRAY_CAPACITY(v, capacity);
+}
+
+// 一般数组转换为紧凑的数字数组（调用者已确认都可以紧凑存储），容量不变
+static void lept_pack_array(lept_value* v) {
+    size_t capacity = LEPT_ARRAY_CAPACITY(v);
+    if (v->flags & LEPT_FLAG_BORROWED) {
+        // arena中的元素数组不能换成堆内存（无人释放），就地改写：第 i 个double只覆盖已经读过的元素
+        lept_set_packed(v, (double*)v->u.a.e, v->u.a.e, v->u.a.size);
+        v->flags |= LEPT_FLAG_BORROWED;
+        return;
+    }
+    double* n = capacity > 0 ? (double*)lept_heap_realloc(NULL, capacity * sizeof(double)) : NULL;
+    lept_value* e = v->u.a.e;
+    size_t size = v->u.a.size;
+    lept_set_packed(v, n, e, size);  // 数字不持有内存，原数组直接丢弃
+    lept_heap_free(e);
+    LEPT_SET_ARRAY_CAPACITY(v, capacity);
+}
+
+// 读取数组元素而不改变数组：紧凑数组的元素临时展开到 *tmp
+static const lept_value* lept_array_at(const lept_value* v, size_t index, lept_value* tmp) {
+    if (!(v->flags & LEPT_FLAG_PACKED))
+        return &v->u.a.e[index];
+    lept_unpack_number(tmp, LEPT_PACKED(v)[index]);
+    return tmp;
+}
+
 lept_value* lept_get_array_element(const lept_value* v, size_t index) {
     assert(v != NULL && v->type == LEPT_ARRAY);
+    LEPT_MATERIALIZE(v);
     assert(index < v->u.a.size);
+    if (v->flags & LEPT_FLAG_PACKED)  // 返回的元素可以被改写为任意类型，先转换回一般数组
+        lept_unpack_array((lept_value*)v);
     return &v->u.a.e[index];
 }
 
+double lept_get_array_number(const lept_value* v, size_t index) {
+    assert(v != NULL && v->type == LEPT_ARRAY);
+    LEPT_MATERIALIZE(v);
+    assert(index < v->u.a.size);
+    if (v->flags & LEPT_FLAG_PACKED)
+        return LEPT_PACKED(v)[index];
+    return lept_get_number(&v->u.a.e[index]);
+}
+
+int lept_get_number_array(const lept_value* v, const double** n, size_t* len) {
+    assert(v != NULL && v->type == LEPT_ARRAY && n != NULL && len != NULL);
+    LEPT_MATERIALIZE(v);
+    if (!(v->flags & LEPT_FLAG_PACKED)) {
+        for (size_t i = 0; i < v->u.a.size; i++)
+            if (!lept_number_packable(&v->u.a.e[i]))
+                return FALSE;
+        lept_pack_array((lept_value*)v);  // 首次批量访问时转换，之前取得的元素指针失效
+    }
+    *n = LEPT_PACKED(v);
+    *len = v->u.a.size;
+    return TRUE;
+}
+
+void lept_set_number_array(lept_value* v, const double* n, size_t len) {
+    assert(v != NULL && (n != NULL || len == 0));
+    lept_free(v);
+    v->type = LEPT_ARRAY;
+    v->flags = LEPT_FLAG_PACKED;
+    v->u.a.e = len > 0 ? (lept_value*)lept_heap_realloc(NULL, len * sizeof(double)) : NULL;
+    if (len > 0)
+        memcpy(v->u.a.e, n, len * sizeof(double));
+    v->u.a.size = len;
+    LEPT_SET_ARRAY_CAPACITY(v, len);
+}
+
+void lept_append_number_array(lept_value* v, const double* n, size_t len) {
+    const double* p;
+    size_t size, capacity;
+    assert(v != NULL && v->type == LEPT_ARRAY && (n != NULL || len == 0));
+    LEPT_MATERIALIZE(v);
+    if (!lept_get_number_array(v, &p, &size)) {  // 已经有非数字元素，逐个追加
+        for (size_t i = 0; i < len; i++)
+            lept_set_number(lept_pushback_array_element(v), n[i]);
+        return;
+    }
+    capacity = LEPT_ARRAY_CAPACITY(v);
+    if (size + len > capacity)
+        lept_reserve_array(v, size + len > capacity * 2 ? size + len : capacity * 2);
+    if (len > 0)
+        memcpy(LEPT_PACKED(v) + size, n, len * sizeof(double));
+    v->u.a.size += len;
+}
+
 // 原始数组在解析完的大小是固定的，现在修改其数据结构为动态数组，类似于vector
 // 也就是初始分配一个大的空间，解析时在里面加入元素，超过capacity再realloc内存
 void lept_set_array(lept_value* v, size_t capacity) {
@@ -513,8 +3312,8 @@ void lept_set_array(lept_value* v, size_t capacity) {
     lept_free(v);
     v->type = LEPT_ARRAY;
     v->u.a.size = 0;
-    v->u.a.capacity = capacity;
-    v->u.a.e = capacity > 0 ? (lept_value*)malloc(capacity * sizeof(lept_value)) : NULL;
+    v->u.a.e = capacity > 0 ? (lept_value*)lept_heap_realloc(NULL, capacity * sizeof(lept_value)) : NULL;
+    LEPT_SET_ARRAY_CAPACITY(v, capacity);
     if (v->u.a.e)
         for (size_t i = 0; i < capacity; i++)
             lept_init(&v->u.a.e[i]);
@@ -522,45 +3321,67 @@ void lept_set_array(lept_value* v, size_t capacity) {
 
 size_t lept_get_array_capacity(const lept_value* v) {
     assert(v != NULL && v->type == LEPT_ARRAY);
-    return v->u.a.capacity;
+    LEPT_MATERIALIZE(v);
+    return LEPT_ARRAY_CAPACITY(v);
 }
 
 void lept_reserve_array(lept_value* v, size_t capacity) {
     assert(v != NULL && v->type == LEPT_ARRAY);
-    if (v->u.a.capacity < capacity) {
-        v->u.a.capacity = capacity;
-        v->u.a.e = (lept_value*)realloc(v->u.a.e, capacity * sizeof(lept_value));
+    LEPT_MATERIALIZE(v);
+    if (LEPT_ARRAY_CAPACITY(v) < capacity) {
+        if (v->flags & LEPT_FLAG_BORROWED) {  // 借用的元素数组不能realloc，拷贝到堆上
+            lept_value* e = (lept_value*)lept_heap_realloc(NULL, capacity * LEPT_ELEMENT_SIZE(v));
+            memcpy(e, v->u.a.e, v->u.a.size * LEPT_ELEMENT_SIZE(v));
+            v->u.a.e = e;
+            v->flags &= ~LEPT_FLAG_BORROWED;
+        } else
+            v->u.a.e = (lept_value*)lept_heap_realloc(v->u.a.e, capacity * LEPT_ELEMENT_SIZE(v));
+        LEPT_SET_ARRAY_CAPACITY(v, capacity);
     }
 }
 
 void lept_shrink_array(lept_value* v) {
     assert(v != NULL && v->type == LEPT_ARRAY);
-    if (v->u.a.capacity > v->u.a.size) {
-        v->u.a.capacity = v->u.a.size;
-        v->u.a.e = (lept_value*)realloc(v->u.a.e, v->u.a.capacity * sizeof(lept_value));
+    LEPT_MATERIALIZE(v);
+    if (v->flags & LEPT_FLAG_BORROWED)  // arena中的数组本就没有冗余
+        return;
+    if (LEPT_ARRAY_CAPACITY(v) > v->u.a.size) {
+        v->u.a.e = (lept_value*)lept_heap_realloc(v->u.a.e, v->u.a.size * LEPT_ELEMENT_SIZE(v));
+        LEPT_SET_ARRAY_CAPACITY(v, v->u.a.size);
     }
 }
 
 lept_value* lept_pushback_array_element(lept_value* v) {
     assert(v != NULL && v->type == LEPT_ARRAY);
-    if (v->u.a.size == v->u.a.capacity)
+    LEPT_MATERIALIZE(v);
+    if (v->flags & LEPT_FLAG_PACKED)
+        lept_unpack_array(v);
+    if (v->u.a.size == LEPT_ARRAY_CAPACITY(v))
         // 若容量为 0，则分配 1 个元素；其他情况倍增容量
-        lept_reserve_array(v, v->u.a.capacity == 0 ? 1 : v->u.a.capacity * 2);
+        lept_reserve_array(v, v->u.a.size == 0 ? 1 : v->u.a.size * 2);
     lept_init(&v->u.a.e[v->u.a.size]);
     return &v->u.a.e[v->u.a.size++];
 }
 
 void lept_popback_array_element(lept_value* v) {
-    assert(v != NULL && v->type == LEPT_ARRAY && v->u.a.size > 0);
-    lept_free(&v->u.a.e[--v->u.a.size]);
+    assert(v != NULL && v->type == LEPT_ARRAY);
+    LEPT_MATERIALIZE(v);
+    assert(v->u.a.size > 0);
+    if (v->flags & LEPT_FLAG_PACKED)
+        v->u.a.size--;
+    else
+        lept_free(&v->u.a.e[--v->u.a.size]);
 }
 
 lept_value* lept_insert_array_element(lept_value* v, size_t index) {
     assert(v != NULL && v->type == LEPT_ARRAY);
+    LEPT_MATERIALIZE(v);
     if (index >= v->u.a.size)
         return lept_pushback_array_element(v);
-    if (v->u.a.size == v->u.a.capacity)
-        lept_reserve_array(v, v->u.a.capacity * 2);
+    if (v->flags & LEPT_FLAG_PACKED)
+        lept_unpack_array(v);
+    if (v->u.a.size == LEPT_ARRAY_CAPACITY(v))
+        lept_reserve_array(v, v->u.a.size * 2);
     for (size_t i = v->u.a.size; i > index; i--)
         memcpy(v->u.a.e + i, v->u.a.e + i - 1, sizeof(lept_value));
     v->u.a.size++;
@@ -569,9 +3390,15 @@ lept_value* lept_insert_array_element(lept_value* v, size_t index) {
 
 void lept_erase_array_element(lept_value* v, size_t index, size_t count) {
     assert(v != NULL && v->type == LEPT_ARRAY);
+    LEPT_MATERIALIZE(v);
     if (index >= v->u.a.size)
         return;
     size_t limit = count < v->u.a.size - index ? count : v->u.a.size - index;
+    if (v->flags & LEPT_FLAG_PACKED) {
+        memmove(LEPT_PACKED(v) + index, LEPT_PACKED(v) + index + limit, (v->u.a.size - index - limit) * sizeof(double));
+        v->u.a.size -= limit;
+        return;
+    }
     for (size_t i = 0; i < limit; i++)
         lept_free(&v->u.a.e[index + i]);
     if (limit)
@@ -586,34 +3413,79 @@ void lept_clear_array(lept_value* v) {
 
 size_t lept_get_object_size(const lept_value* v) {
     assert(v != NULL && v->type == LEPT_OBJECT);
+    LEPT_MATERIALIZE(v);
     return v->u.o.size;
 }
 
 const char* lept_get_object_key(const lept_value* v, size_t index) {
     assert(v != NULL && v->type == LEPT_OBJECT);
+    LEPT_MATERIALIZE(v);
     assert(index < v->u.o.size);
     return v->u.o.m[index].k;
 }
 
 size_t lept_get_object_key_length(const lept_value* v, size_t index) {
     assert(v != NULL && v->type == LEPT_OBJECT);
+    LEPT_MATERIALIZE(v);
     assert(index < v->u.o.size);
     return v->u.o.m[index].klen;
 }
 
 lept_value* lept_get_object_value(const lept_value* v, size_t index) {
     assert(v != NULL && v->type == LEPT_OBJECT);
+    LEPT_MATERIALIZE(v);
     assert(index < v->u.o.size);
     return &v->u.o.m[index].v;
 }
 
+// 查找键，h 为 lept_hash_key(key, klen)；没有索引的对象顺序查找，用不到 h
+// 索引只在建立和修改对象时生成（见 LEPT_OBJECT_HASH_THRESHOLD），查找本身从不分配内存、不移动成员
+static size_t lept_find_object_index_hashed(const lept_value* v, const char* key, size_t klen, uint32_t h) {
+    const lept_bucket* b;
+    const lept_member* m;
+    size_t i, mask;
+    if (!(v->flags & LEPT_FLAG_HASHED)) {
+        for (i = 0; i < v->u.o.size; i++)
+            if (v->u.o.m[i].klen == klen && (v->u.o.m[i].k == key || memcmp(v->u.o.m[i].k, key, klen) == 0))
+                return i;  // 驻留的键先比较指针
+        return LEPT_KEY_NOT_EXIST;
+    }
+    b = LEPT_BUCKETS(v);
+    mask = lept_bucket_count(LEPT_OBJECT_CAPACITY(v)) - 1;
+    for (i = h & mask; b[i].index; i = (i + 1) & mask) {
+        m = &v->u.o.m[b[i].index - 1];
+        if (b[i].hash == h && m->klen == klen && (m->k == key || memcmp(m->k, key, klen) == 0))
+            return b[i].index - 1;
+    }
+    return LEPT_KEY_NOT_EXIST;
+}
+
 size_t lept_find_object_index(const lept_value* v, const char* key, size_t klen) {
-    size_t i;
     assert(v != NULL && v->type == LEPT_OBJECT && key != NULL);
-    for (i = 0; i < v->u.o.size; i++)
-        if (v->u.o.m[i].klen == klen && memcmp(v->u.o.m[i].k, key, klen) == 0)
-            return i;
-    return LEPT_KEY_NOT_EXIST;
+    LEPT_MATERIALIZE(v);
+    if (!(v->flags & LEPT_FLAG_HASHED))
+        return lept_find_object_index_hashed(v, key, klen, 0);
+    return lept_find_object_index_hashed(v, key, klen, lept_hash_key(key, klen));
+}
+
+// 位置缓存是否命中：hint 处的键与 key 相同
+static int lept_object_hint_match(const lept_value* v, const char* key, size_t klen, size_t hint) {
+    const lept_member* m;
+    if (hint >= v->u.o.size)
+        return FALSE;
+    m = &v->u.o.m[hint];
+    return m->klen == klen && (m->k == key || memcmp(m->k, key, klen) == 0);
+}
+
+size_t lept_find_object_index_hint(const lept_value* v, const char* key, size_t klen, size_t* hint) {
+    size_t index;
+    assert(v != NULL && v->type == LEPT_OBJECT && key != NULL && hint != NULL);
+    LEPT_MATERIALIZE(v);
+    if (lept_object_hint_match(v, key, klen, *hint))
+        return *hint;
+    if ((index = lept_find_object_index(v, key, klen)) != LEPT_KEY_NOT_EXIST)
+        *hint = index;
+    return index;
 }
 
 lept_value* lept_find_object_value(const lept_value* v, const char* key, size_t klen) {
@@ -621,20 +3493,39 @@ lept_value* lept_find_object_value(const lept_value* v, const char* key, size_t
     return index != LEPT_KEY_NOT_EXIST ? &v->u.o.m[index].v : NULL;
 }
 
+// 把借用的键全部拷贝到堆上，之后新旧键都由对象自己释放
+static void lept_own_object_keys(lept_value* v) {
+    for (size_t i = 0; i < v->u.o.size; i++) {
+        lept_member* m = &v->u.o.m[i];
+        char* k = (char*)malloc(m->klen + 1);
+        memcpy(k, m->k, m->klen);
+        k[m->klen] = '\0';
+        m->k = k;
+    }
+    v->flags &= ~LEPT_FLAG_KEYS_BORROWED;
+}
+
 lept_value* lept_set_object_value(lept_value* v, const char* key, size_t klen) {
     assert(v != NULL && v->type == LEPT_OBJECT && key != NULL);
+    LEPT_MATERIALIZE(v);
     size_t index = lept_find_object_index(v, key, klen);
     if (index != LEPT_KEY_NOT_EXIST)
         return &v->u.o.m[index].v;
     else {  // add a new key-value pair
-        if (v->u.o.size == v->u.o.capacity)
-            lept_reserve_object(v, v->u.o.capacity == 0 ? 1 : v->u.o.capacity * 2);
+        if (v->u.o.size == LEPT_OBJECT_CAPACITY(v))
+            lept_reserve_object(v, v->u.o.size == 0 ? 1 : v->u.o.size * 2);
+        if (v->flags & LEPT_FLAG_KEYS_BORROWED)
+            lept_own_object_keys(v);
         lept_member* m = &v->u.o.m[v->u.o.size++];
         memcpy(m->k = (char*)malloc(klen + 1), key, klen);
         m->k[klen] = '\0';
         m->klen = klen;
         lept_init(&m->v);
-        return &m->v;
+        if (v->flags & LEPT_FLAG_HASHED)
+            lept_object_index_insert(v, v->u.o.size - 1);
+        else if (v->u.o.size >= LEPT_OBJECT_HASH_THRESHOLD)
+            lept_object_hash(v);
+        return &v->u.o.m[v->u.o.size - 1].v;
     }
 }
 
@@ -643,8 +3534,8 @@ void lept_set_object(lept_value* v, size_t capacity) {
     lept_free(v);
     v->type = LEPT_OBJECT;
     v->u.o.size = 0;
-    v->u.o.capacity = capacity;
-    v->u.o.m = capacity > 0 ? (lept_member*)malloc(capacity * sizeof(lept_member)) : NULL;
+    v->u.o.m = capacity > 0 ? (lept_member*)lept_heap_realloc(NULL, capacity * sizeof(lept_member)) : NULL;
+    LEPT_SET_OBJECT_CAPACITY(v, capacity);
     if (v->u.o.m)
         for (size_t i = 0; i < capacity; i++)
             lept_init(&v->u.o.m[i].v);
@@ -652,48 +3543,158 @@ void lept_set_object(lept_value* v, size_t capacity) {
 
 size_t lept_get_object_capacity(const lept_value* v) {
     assert(v != NULL && v->type == LEPT_OBJECT);
-    return v->u.o.capacity;
+    LEPT_MATERIALIZE(v);
+    return LEPT_OBJECT_CAPACITY(v);
 }
 
 void lept_reserve_object(lept_value* v, size_t capacity) {
     assert(v != NULL && v->type == LEPT_OBJECT);
-    if (v->u.o.capacity < capacity) {
-        v->u.o.capacity = capacity;
-        v->u.o.m = (lept_member*)realloc(v->u.a.e, capacity * sizeof(lept_member));
-    }
+    LEPT_MATERIALIZE(v);
+    if (LEPT_OBJECT_CAPACITY(v) < capacity)
+        lept_object_realloc(v, capacity);  // 借用的成员数组不能realloc，会拷贝到堆上
 }
 
 void lept_shrink_object(lept_value* v) {
     assert(v != NULL && v->type == LEPT_OBJECT);
-    if (v->u.o.capacity > v->u.a.size) {
-        v->u.o.capacity = v->u.a.size;
-        v->u.o.m = (lept_member*)realloc(v->u.a.e, v->u.o.capacity * sizeof(lept_member));
-    }
+    LEPT_MATERIALIZE(v);
+    if (v->flags & LEPT_FLAG_BORROWED)
+        return;
+    if (LEPT_OBJECT_CAPACITY(v) > v->u.o.size)
+        lept_object_realloc(v, v->u.o.size);
 }
 
 void lept_remove_object_value_index(lept_value* v, size_t index) {
-    assert(v != NULL && v->type == LEPT_OBJECT && index < v->u.o.size);
-    free(v->u.o.m[index].k);
+    assert(v != NULL && v->type == LEPT_OBJECT);
+    LEPT_MATERIALIZE(v);
+    assert(index < v->u.o.size);
+    lept_free_key(v, &v->u.o.m[index]);
     lept_free(&v->u.o.m[index].v);
     for (size_t i = index; i < v->u.o.size - 1; i++)
         memcpy(&v->u.o.m[i], &v->u.o.m[i + 1], sizeof(lept_member));
     v->u.o.size--;
+    if (v->flags & LEPT_FLAG_HASHED)  // 之后的成员下标都变了
+        lept_object_index_rebuild(v);
 }
 
 void lept_remove_object_value_key(lept_value* v, const char* key, size_t klen) {
     assert(v != NULL && v->type == LEPT_OBJECT);
+    LEPT_MATERIALIZE(v);
     size_t index = lept_find_object_index(v, key, klen);
-    if (index)
+    if (index != LEPT_KEY_NOT_EXIST)
         lept_remove_object_value_index(v, index);
 }
 
 void lept_clear_object(lept_value* v) {
     assert(v != NULL && v->type == LEPT_OBJECT);
+    LEPT_MATERIALIZE(v);
     for (size_t i = 0; i < v->u.o.size; i++) {
-        free(v->u.o.m[i].k);
+        lept_free_key(v, &v->u.o.m[i]);
         lept_free(&v->u.o.m[i].v);
     }
     v->u.o.size = 0;
+    if (v->flags & LEPT_FLAG_HASHED)
+        lept_object_index_rebuild(v);
+}
+
+int lept_pointer_compile(lept_pointer* p, const char* path) {
+    lept_pointer_token* t;
+    const char* s;
+    char* k;
+    size_t i, count = 0, len;
+    assert(p != NULL && path != NULL);
+    if (path[0] != '\0' && path[0] != '/')
+        return FALSE;
+    for (s = path; *s; s++)
+        if (*s == '/')
+            count++;
+        else if (*s == '~' && s[1] != '0' && s[1] != '1')
+            return FALSE;
+    len = s - path;
+    // 解码后的键（各带一个'\0'）总长度不超过指针本身
+    t = (lept_pointer_token*)malloc(count * sizeof(lept_pointer_token) + len + 1);
+    k = (char*)(t + count);
+    for (s = path, i = 0; i < count; i++) {
+        t[i].key = k;
+        for (s++; *s && *s != '/'; s++)
+            *k++ = *s == '~' ? (*++s == '0' ? '~' : '/') : *s;
+        t[i].len = k - t[i].key;
+        *k++ = '\0';
+        t[i].index = lept_token_index(t[i].key, t[i].len);
+        t[i].hash = lept_hash_key(t[i].key, t[i].len);
+        t[i].hint = 0;
+    }
+    p->tokens = t;
+    p->count = count;
+    return TRUE;
+}
+
+void lept_pointer_free(lept_pointer* p) {
+    assert(p != NULL);
+    free(p->tokens);
+    p->tokens = NULL;
+    p->count = 0;
+}
+
+// 在对象中查找token：同 lept_find_object_index_hint，但用预先算好的哈希值
+static size_t lept_pointer_find(const lept_value* v, lept_pointer_token* t) {
+    size_t index;
+    LEPT_MATERIALIZE(v);
+    if (lept_object_hint_match(v, t->key, t->len, t->hint))
+        return t->hint;
+    if ((index = lept_find_object_index_hashed(v, t->key, t->len, t->hash)) != LEPT_KEY_NOT_EXIST)
+        t->hint = index;
+    return index;
+}
+
+lept_value* lept_pointer_get(lept_pointer* p, const lept_value* v) {
+    size_t i, index;
+    assert(p != NULL && v != NULL);
+    for (i = 0; i < p->count; i++) {
+        lept_pointer_token* t = &p->tokens[i];
+        if (v->type == LEPT_OBJECT) {
+            if ((index = lept_pointer_find(v, t)) == LEPT_KEY_NOT_EXIST)
+                return NULL;
+            v = &v->u.o.m[index].v;
+        } else if (v->type == LEPT_ARRAY) {
+            if (t->index >= lept_get_array_size(v))  // 非下标的token是 LEPT_KEY_NOT_EXIST，总是越界
+                return NULL;
+            v = lept_get_array_element(v, t->index);
+        } else
+            return NULL;
+    }
+    return (lept_value*)v;
+}
+
+lept_value* lept_pointer_set(lept_pointer* p, lept_value* v) {
+    size_t i, index, size;
+    assert(p != NULL && v != NULL);
+    for (i = 0; i < p->count; i++) {
+        lept_pointer_token* t = &p->tokens[i];
+        int append = t->len == 1 && t->key[0] == '-';
+        if (v->type == LEPT_NULL) {
+            if (append)
+                lept_set_array(v, 0);
+            else
+                lept_set_object(v, 0);
+        }
+        if (v->type == LEPT_OBJECT) {
+            if ((index = lept_pointer_find(v, t)) == LEPT_KEY_NOT_EXIST) {
+                t->hint = v->u.o.size;  // 新成员追加在末尾
+                v = lept_set_object_value(v, t->key, t->len);
+            } else
+                v = &v->u.o.m[index].v;
+        } else if (v->type == LEPT_ARRAY) {
+            size = lept_get_array_size(v);
+            if (append || t->index == size)
+                v = lept_pushback_array_element(v);
+            else if (t->index < size)
+                v = lept_get_array_element(v, t->index);
+            else
+                return NULL;
+        } else
+            return NULL;
+    }
+    return v;
 }
 
 void lept_stringify_string_deprecated(lept_context* c, const char* str, size_t size) {
@@ -720,55 +3721,321 @@ void lept_stringify_string_deprecated(lept_context* c, const char* str, size_t s
     lept_context_push(c, '\"');
 }
 
-// 优化1：提前分配足够的内存，避免了lept_context_push_len中的频繁检查内存是否充足的负担，以空间换时间
-// 优化2：手动编写十六进制输出，避免了调用 sprinf 的内存开销
-static void lept_stringify_string(lept_context* c, const char* s, size_t len) {
+// 流式输出：缓冲区用了一半以上时交给写回调，清空后继续使用
+static int lept_stringify_flush(lept_context* c) {
+    if (c->top > c->size)  // 调用者的缓冲区已经放不下
+        return LEPT_STRINGIFY_BUFFER_TOO_SMALL;
+    if (!c->write || c->top < c->size / 2)
+        return LEPT_STRINGIFY_OK;
+    if (!c->write(c->user, c->stack, c->top))
+        return LEPT_STRINGIFY_WRITE_FAILED;
+    c->top = 0;
+    return LEPT_STRINGIFY_OK;
+}
+
+// 转义一个 '"'、'\\' 或控制字符写到p（至少6字节），返回结尾位置
+// 优化：手动编写十六进制输出，避免了调用 sprinf 的内存开销
+static char* lept_escape_char(char* p, unsigned char ch) {
     static const char hex_digits[] = { '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'B', 'C', 'D', 'E', 'F' };
-    size_t i, size;
-    char* head, *p;
+    *p++ = '\\';
+    switch (ch) {
+        case '\"': *p++ = '\"'; break;
+        case '\\': *p++ = '\\'; break;
+        case '\b': *p++ = 'b';  break;
+        case '\f': *p++ = 'f';  break;
+        case '\n': *p++ = 'n';  break;
+        case '\r': *p++ = 'r';  break;
+        case '\t': *p++ = 't';  break;
+        default:
+            *p++ = 'u'; *p++ = '0'; *p++ = '0';
+            *p++ = hex_digits[ch >> 4];
+            *p++ = hex_digits[ch & 15];
+    }
+    return p;
+}
+
+// 与解析共用 lept_scan_string 一次找出16/32字节中需要转义的字节，其间不需要转义的一段直接memcpy，
+// 栈只按实际的转义预留空间（每个转义6字节），不再为整个字符串预留6倍
+// 流式输出时每段不超过半个缓冲区，写出后再处理下一段，缓冲区不随字符串长度增长
+static int lept_stringify_string(lept_context* c, const char* s, size_t len) {
+    const char* end = s + len, *lim, *q;
+    size_t chunk = c->write ? c->size / 2 - 8 : len;
+    char* p;
+    int ret;
     assert(s != NULL);
-    p = head = lept_context_push_len(c, size = len * 6 + 2); /* "\u00xx..." */
-    *p++ = '"';
-    for (i = 0; i < len; i++) {
-        unsigned char ch = (unsigned char)s[i];
-        switch (ch) {
-            case '\"': *p++ = '\\'; *p++ = '\"'; break;
-            case '\\': *p++ = '\\'; *p++ = '\\'; break;
-            case '\b': *p++ = '\\'; *p++ = 'b';  break;
-            case '\f': *p++ = '\\'; *p++ = 'f';  break;
-            case '\n': *p++ = '\\'; *p++ = 'n';  break;
-            case '\r': *p++ = '\\'; *p++ = 'r';  break;
-            case '\t': *p++ = '\\'; *p++ = 't';  break;
-            default:
-                if (ch < 0x20) {
-                    *p++ = '\\'; *p++ = 'u'; *p++ = '0'; *p++ = '0';
-                    *p++ = hex_digits[ch >> 4];
-                    *p++ = hex_digits[ch & 15];
-                }
-                else
-                    *p++ = s[i];
+    if ((ret = lept_stringify_flush(c)) != LEPT_STRINGIFY_OK)
+        return ret;
+    lept_context_push(c, '"');
+    while (s < end) {
+        lim = (size_t)(end - s) > chunk ? s + chunk : end;
+        q = lept_scan_string(s, lim);
+        PUTS(c, s, q - s);
+        if (q < lim) {
+            if (c->fixed && c->top + 6 > c->size) {  // 不能为预留而增长，按实际长度写入
+                char buffer[6];
+                PUTS(c, buffer, lept_escape_char(buffer, (unsigned char)*q++) - buffer);
+            } else {
+                p = lept_context_push_len(c, 6);
+                c->top -= 6 - (lept_escape_char(p, (unsigned char)*q++) - p);
+            }
+        }
+        s = q;
+        if ((ret = lept_stringify_flush(c)) != LEPT_STRINGIFY_OK)
+            return ret;
+    }
+    lept_context_push(c, '"');
+    return LEPT_STRINGIFY_OK;
+}
+
+/*
+* 数字格式化：Grisu2（Florian Loitsch），不依赖sprintf和locale
+* 输出的数字串总能被 lept_parse 精确还原，绝大多数情况下也是最短的
+* 绝对值小于2^53的整数直接输出
+*/
+typedef struct {
+    uint64_t f;
+    int e;
+} lept_diyfp;  // f * 2^e
+
+static lept_diyfp lept_diyfp_make(uint64_t f, int e) {
+    lept_diyfp x;
+    x.f = f;
+    x.e = e;
+    return x;
+}
+
+// 乘积的高64位（四舍五入）
+static lept_diyfp lept_diyfp_mul(lept_diyfp a, lept_diyfp b) {
+    uint64_t hi, lo = lept_umul128(a.f, b.f, &hi);
+    return lept_diyfp_make(hi + (lo >> 63), a.e + b.e + 64);
+}
+
+static lept_diyfp lept_diyfp_normalize(lept_diyfp x) {
+    int s = lept_clz64(x.f);
+    return lept_diyfp_make(x.f << s, x.e - s);
+}
+
+// 10^-K 的近似值，使乘积的二进制指数落在 [-60, -32]；借用数字解析的幂表，每隔8个取一个
+static lept_diyfp lept_cached_power(int e, int* K) {
+    double dk = (-61 - e) * 0.30102999566398114 + 347;  // dk需要向上取整
+    int k = (int)dk, index, exp10;
+    if (dk - k > 0.0)
+        k++;
+    index = (k >> 3) + 1;
+    exp10 = LEPT_POW10_MIN + (index << 3);
+    *K = -exp10;
+    return lept_diyfp_make(lept_pow10_128[index << 3][1] + (lept_pow10_128[index << 3][0] >> 63),
+        (int)((217706 * exp10) >> 16) - 63);
+}
+
+// 最后一位尽量向 W 靠近
+static void lept_grisu_round(char* buffer, int len, uint64_t delta, uint64_t rest, uint64_t ten_kappa, uint64_t wp_w) {
+    while (rest < wp_w && delta - rest >= ten_kappa &&
+           (rest + ten_kappa < wp_w || wp_w - rest > rest + ten_kappa - wp_w)) {
+        buffer[len - 1]--;
+        rest += ten_kappa;
+    }
+}
+
+// 在 (Mp - delta, Mp] 内生成尽量少的数字
+static int lept_digit_gen(lept_diyfp W, lept_diyfp Mp, uint64_t delta, char* buffer, int* K) {
+    static const uint64_t pow10[] = {
+        1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL, 1000000000ULL,
+        10000000000ULL, 100000000000ULL, 1000000000000ULL, 10000000000000ULL, 100000000000000ULL,
+        1000000000000000ULL, 10000000000000000ULL, 100000000000000000ULL, 1000000000000000000ULL,
+        10000000000000000000ULL
+    };
+    const int shift = -Mp.e;
+    const uint64_t one = (uint64_t)1 << shift, wp_w = Mp.f - W.f;
+    uint32_t p1 = (uint32_t)(Mp.f >> shift), d;
+    uint64_t p2 = Mp.f & (one - 1), rest;
+    int kappa = 1, len = 0;
+    while (kappa < 10 && p1 >= pow10[kappa])
+        kappa++;
+    // 整数部分
+    while (kappa > 0) {
+        d = p1 / (uint32_t)pow10[kappa - 1];
+        p1 %= (uint32_t)pow10[kappa - 1];
+        if (d || len)
+            buffer[len++] = (char)('0' + d);
+        kappa--;
+        if ((rest = ((uint64_t)p1 << shift) + p2) <= delta) {
+            *K += kappa;
+            lept_grisu_round(buffer, len, delta, rest, pow10[kappa] << shift, wp_w);
+            return len;
         }
     }
-    *p++ = '"';
-    c->top -= size - (p - head);
+    // 小数部分
+    while (1) {
+        p2 *= 10;
+        delta *= 10;
+        d = (uint32_t)(p2 >> shift);
+        if (d || len)
+            buffer[len++] = (char)('0' + d);
+        p2 &= one - 1;
+        kappa--;
+        if (p2 < delta) {
+            *K += kappa;
+            lept_grisu_round(buffer, len, delta, p2, one, -kappa < 20 ? wp_w * pow10[-kappa] : 0);
+            return len;
+        }
+    }
+}
+
+// d > 0，数字写入buffer，返回位数；值为 buffer * 10^K
+static int lept_grisu2(double d, char* buffer, int* K) {
+    uint64_t bits, f;
+    int e;
+    lept_diyfp v, mp, mm, c;
+    memcpy(&bits, &d, sizeof(d));
+    f = bits & (((uint64_t)1 << 52) - 1);
+    e = (int)(bits >> 52 & 0x7FF);
+    if (e) {
+        f |= (uint64_t)1 << 52;
+        e -= 1075;
+    } else
+        e = -1074;
+    // 与相邻double的中点 m+、m-，规格化到相同的指数
+    mp = lept_diyfp_make((f << 1) + 1, e - 1);
+    while (!(mp.f & ((uint64_t)1 << 53))) {
+        mp.f <<= 1;
+        mp.e--;
+    }
+    mp.f <<= 10;
+    mp.e -= 10;
+    mm = (f == (uint64_t)1 << 52) ? lept_diyfp_make((f << 2) - 1, e - 2) : lept_diyfp_make((f << 1) - 1, e - 1);
+    mm.f <<= mm.e - mp.e;
+    mm.e = mp.e;
+
+    c = lept_cached_power(mp.e, K);
+    v = lept_diyfp_mul(lept_diyfp_normalize(lept_diyfp_make(f, e)), c);
+    mp = lept_diyfp_mul(mp, c);
+    mm = lept_diyfp_mul(mm, c);
+    mm.f++;
+    mp.f--;
+    return lept_digit_gen(v, mp, mp.f - mm.f, buffer, K);
+}
+
+static char* lept_write_uint64(char* p, uint64_t u) {
+    char buf[20];
+    int n = 0;
+    do {
+        buf[n++] = (char)('0' + u % 10);
+        u /= 10;
+    } while (u);
+    while (n)
+        *p++ = buf[--n];
+    return p;
+}
+
+// 把double写到p（至少32字节），返回结尾位置
+// 与 "%.17g" 的格式一致：首位数字的十进制指数在 [-4, 17) 时用小数形式，否则用科学计数法
+static char* lept_dtoa(double d, char* p) {
+    char digits[20];
+    int len, K, X, i;
+    uint64_t bits;
+    if (!isfinite(d)) {  // JSON没有无穷大和NaN，与 JSON.stringify 一样输出 null
+        memcpy(p, "null", 4);
+        return p + 4;
+    }
+    memcpy(&bits, &d, sizeof(d));
+    if (bits >> 63) {
+        *p++ = '-';
+        d = -d;
+    }
+    if (d < 9007199254740992.0 && d == (double)(uint64_t)d)  // 整数快速路径，包括0
+        return lept_write_uint64(p, (uint64_t)d);
+    len = lept_grisu2(d, digits, &K);
+    X = len + K - 1;
+    if (X >= -4 && X < 17) {
+        if (K >= 0) {  // 整数
+            memcpy(p, digits, len);
+            memset(p + len, '0', K);
+            return p + len + K;
+        }
+        if (X >= 0) {  // ddd.ddd
+            memcpy(p, digits, X + 1);
+            p[X + 1] = '.';
+            memcpy(p + X + 2, digits + X + 1, len - X - 1);
+            return p + len + 1;
+        }
+        *p++ = '0';  // 0.000ddd
+        *p++ = '.';
+        for (i = -1; i > X; i--)
+            *p++ = '0';
+        memcpy(p, digits, len);
+        return p + len;
+    }
+    *p++ = digits[0];
+    if (len > 1) {
+        *p++ = '.';
+        memcpy(p, digits + 1, len - 1);
+        p += len - 1;
+    }
+    *p++ = 'e';
+    if (X < 0) {
+        *p++ = '-';
+        X = -X;
+    } else
+        *p++ = '+';
+    return lept_write_uint64(p, (uint64_t)X);
+}
+
+// 把数字写到p（至少32字节），返回结尾位置
+static char* lept_write_number(char* p, const lept_value* v) {
+    if (v->flags & LEPT_FLAG_INT64) {
+        if (v->u.i < 0)
+            *p++ = '-';
+        return lept_write_uint64(p, v->u.i < 0 ? 0 - (uint64_t)v->u.i : (uint64_t)v->u.i);
+    }
+    if (v->flags & LEPT_FLAG_UINT64)
+        return lept_write_uint64(p, v->u.u);
+    return lept_dtoa(v->u.n, p);
+}
+
+// 美化输出：换行，再缩进 depth 层
+static void lept_stringify_indent(lept_context* c, size_t depth) {
+    size_t n = depth * (LEPT_PRETTY_INDENT(c->pretty) ? LEPT_PRETTY_INDENT(c->pretty) : (c->pretty & LEPT_PRETTY_TABS) != 0);
+    if (c->pretty & LEPT_PRETTY_CRLF)
+        lept_context_push(c, '\r');
+    lept_context_push(c, '\n');
+    char* p = (char*)lept_context_push_len(c, n);
+    if (p != NULL)
+        memset(p, c->pretty & LEPT_PRETTY_TABS ? '\t' : ' ', n);
 }
 
-static int lept_stringify_value(lept_context* c, const lept_value* v) {
+static int lept_stringify_value(lept_context* c, const lept_value* v, size_t depth) {
     size_t i;
+    int ret;
+    LEPT_MATERIALIZE(v);
+    if ((ret = lept_stringify_flush(c)) != LEPT_STRINGIFY_OK)
+        return ret;
     switch (v->type) {
         case LEPT_NULL:   PUTS(c, "null",  4); break;
         case LEPT_FALSE:  PUTS(c, "false", 5); break;
         case LEPT_TRUE:   PUTS(c, "true",  4); break;
         case LEPT_NUMBER:
-            c->top -= 32 - sprintf(lept_context_push_len(c, 32), "%.17g", v->u.n);
+            if (c->fixed && c->top + 32 > c->size) {  // 不能为预留而增长，按实际长度写入
+                char buffer[32];
+                PUTS(c, buffer, lept_write_number(buffer, v) - buffer);
+            } else {
+                char* p = lept_context_push_len(c, 32);
+                c->top -= 32 - (lept_write_number(p, v) - p);
+            }
             break;
-        case LEPT_STRING: lept_stringify_string(c, v->u.s.str, v->u.s.size); break;
+        case LEPT_STRING: return lept_stringify_string(c, lept_get_string(v), lept_get_string_length(v));
         case LEPT_ARRAY: 
             lept_context_push(c, '[');
             for (i = 0; i < v->u.a.size; i++) {
+                lept_value tmp;
                 if(i) lept_context_push(c, ',');
-                lept_stringify_value(c, &v->u.a.e[i]);
+                if (c->pretty)
+                    lept_stringify_indent(c, depth + 1);
+                if ((ret = lept_stringify_value(c, lept_array_at(v, i, &tmp), depth + 1)) != LEPT_STRINGIFY_OK)
+                    return ret;
             }
+            if (c->pretty && v->u.a.size)
+                lept_stringify_indent(c, depth);
             lept_context_push(c, ']');
             break;
         case LEPT_OBJECT: {
@@ -776,11 +4043,19 @@ static int lept_stringify_value(lept_context* c, const lept_value* v) {
             lept_member* m;
             for (i = 0; i < v->u.o.size; i++) {
                 if (i) lept_context_push(c, ',');
+                if (c->pretty)
+                    lept_stringify_indent(c, depth + 1);
                 m = v->u.o.m + i;
-                lept_stringify_string(c, m->k, m->klen);
+                if ((ret = lept_stringify_string(c, m->k, m->klen)) != LEPT_STRINGIFY_OK)
+                    return ret;
                 lept_context_push(c, ':');
-                lept_stringify_value(c, &m->v);
+                if (c->pretty)
+                    lept_context_push(c, ' ');
+                if ((ret = lept_stringify_value(c, &m->v, depth + 1)) != LEPT_STRINGIFY_OK)
+                    return ret;
             }
+            if (c->pretty && v->u.o.size)
+                lept_stringify_indent(c, depth);
             lept_context_push(c, '}');
         }
             break;
@@ -788,41 +4063,298 @@ static int lept_stringify_value(lept_context* c, const lept_value* v) {
     return LEPT_STRINGIFY_OK;
 }
 
-int lept_stringify(const lept_value* v, char** json, size_t* length) {
+void lept_writer_init(lept_writer* w) {
+    assert(w != NULL);
+    w->buf = NULL;
+    w->size = w->len = 0;
+    w->flags = 0;
+}
+
+void lept_writer_free(lept_writer* w) {
+    assert(w != NULL);
+    free(w->buf);
+    lept_writer_init(w);
+}
+
+// 把输出缓冲区作为栈，上一次的容量留给这一次
+static void lept_writer_attach(lept_writer* w, lept_context* c) {
+    if (w->size < LEPT_PARSE_STACK_INIT_SIZE)
+        w->buf = (char*)realloc(w->buf, w->size = LEPT_PARSE_STACK_INIT_SIZE);
+    c->stack = w->buf;
+    c->size = w->size;
+    c->top = 0;
+    c->write = NULL;
+    c->pretty = w->flags;
+    c->fixed = 0;
+}
+
+// 取回栈，成功时输出以'\0'结尾
+static void lept_writer_detach(lept_writer* w, lept_context* c, int ok) {
+    if (ok) {
+        w->len = c->top;
+        lept_context_push(c, '\0');  // 栈可能正好用满，结尾的'\0'也要经过容量检查
+    } else
+        w->len = 0;
+    w->buf = c->stack;
+    w->size = c->size;
+}
+
+int lept_stringify_writer(const lept_value* v, lept_writer* w) {
     lept_context c;
     int ret;
-    assert(v != NULL);
+    assert(v != NULL && w != NULL);
+    lept_writer_attach(w, &c);
+    ret = lept_stringify_value(&c, v, 0);
+    lept_writer_detach(w, &c, ret == LEPT_STRINGIFY_OK);
+    return ret;
+}
+
+int lept_stringify(const lept_value* v, char** json, size_t* length) {
+    return lept_stringify_pretty(v, json, length, 0);
+}
+
+int lept_stringify_pretty(const lept_value* v, char** json, size_t* length, int flags) {
+    lept_writer w;
+    int ret;
     assert(json != NULL);
-    c.stack = (char*)malloc(c.size = LEPT_PARSE_STACK_INIT_SIZE);
-    c.top = 0;
-    if ((ret = lept_stringify_value(&c, v)) != LEPT_STRINGIFY_OK) {
-        free(c.stack);
+    lept_writer_init(&w);
+    w.flags = flags;
+    if ((ret = lept_stringify_writer(v, &w)) != LEPT_STRINGIFY_OK) {
+        lept_writer_free(&w);
         *json = NULL;
         return ret;
     }
+    if (length)
+        *length = w.len;
+    *json = w.buf;  // 缓冲区的所有权交给调用者
+    return LEPT_STRINGIFY_OK;
+}
+
+// 转义后的字符串长度，含首尾引号
+static size_t lept_string_size(const char* s, size_t len) {
+    const char* end = s + len;
+    size_t n = len + 2;
+    while ((s = lept_scan_string(s, end)) < end) {
+        unsigned char ch = (unsigned char)*s++;
+        n += (ch == '\"' || ch == '\\' || ch == '\b' || ch == '\f' || ch == '\n' || ch == '\r' || ch == '\t') ? 1 : 5;
+    }
+    return n;
+}
+
+size_t lept_stringify_size(const lept_value* v) {
+    char buf[32];
+    size_t i, n;
+    assert(v != NULL);
+    LEPT_MATERIALIZE(v);
+    switch (v->type) {
+        case LEPT_NULL:   return 4;
+        case LEPT_FALSE:  return 5;
+        case LEPT_TRUE:   return 4;
+        case LEPT_NUMBER: return lept_write_number(buf, v) - buf;
+        case LEPT_STRING: return lept_string_size(lept_get_string(v), lept_get_string_length(v));
+        case LEPT_ARRAY:
+            n = v->u.a.size ? v->u.a.size + 1 : 2;  // 括号和逗号
+            for (i = 0; i < v->u.a.size; i++) {
+                lept_value tmp;
+                n += lept_stringify_size(lept_array_at(v, i, &tmp));
+            }
+            return n;
+        case LEPT_OBJECT:
+            n = v->u.o.size ? v->u.o.size * 2 + 1 : 2;  // 括号、逗号和冒号
+            for (i = 0; i < v->u.o.size; i++)
+                n += lept_string_size(v->u.o.m[i].k, v->u.o.m[i].klen) + lept_stringify_size(&v->u.o.m[i].v);
+            return n;
+    }
+    return 0;
+}
+
+int lept_stringify_buffer(const lept_value* v, char* buf, size_t size, size_t* length) {
+    lept_context c;
+    int ret;
+    assert(v != NULL && buf != NULL);
+    // 缓冲区作为不能增长的栈：剩余空间不够为转义和数字预留时按实际长度写入，真正放不下时中止
+    c.stack = buf;
+    c.size = size;
+    c.top = 0;
+    c.write = NULL;
+    c.pretty = 0;
+    c.fixed = 1;
+    if ((ret = lept_stringify_value(&c, v, 0)) != LEPT_STRINGIFY_OK)
+        return ret;
+    if (c.top >= size)  // 最后一段放不下，或者没有位置放'\0'
+        return LEPT_STRINGIFY_BUFFER_TOO_SMALL;
+    buf[c.top] = '\0';
     if (length)
         *length = c.top;
-    c.stack[c.top] = '\0';
-    *json = c.stack;
     return LEPT_STRINGIFY_OK;
 }
 
+int lept_stringify_to(const lept_value* v, lept_write_fn write, void* user, size_t bufsize, int flags) {
+    lept_context c;
+    int ret;
+    assert(v != NULL && write != NULL);
+    if (bufsize == 0)
+        bufsize = LEPT_STRINGIFY_BUFFER_SIZE;
+    else if (bufsize < LEPT_PARSE_STACK_INIT_SIZE)
+        bufsize = LEPT_PARSE_STACK_INIT_SIZE;
+    c.stack = (char*)malloc(c.size = bufsize);
+    c.top = 0;
+    c.write = write;
+    c.user = user;
+    c.pretty = flags;
+    c.fixed = 0;
+    ret = lept_stringify_value(&c, v, 0);
+    if (ret == LEPT_STRINGIFY_OK && c.top > 0 && !write(user, c.stack, c.top))
+        ret = LEPT_STRINGIFY_WRITE_FAILED;
+    free(c.stack);
+    return ret;
+}
+
+static int lept_write_file(void* user, const char* buf, size_t len) {
+    return fwrite(buf, 1, len, (FILE*)user) == len;
+}
+
+int lept_stringify_file(const lept_value* v, FILE* fp, int flags) {
+    assert(fp != NULL);
+    return lept_stringify_to(v, lept_write_file, fp, 0, flags);
+}
+
+size_t lept_minify(const char* json, size_t len, char* out) {
+    const char* p, *end = json + len, *q;
+    uint64_t escaped = 0, in_string = 0, quote, keep;
+    size_t n = 0, m;
+    lept_block b;
+    char buf[64];
+    assert((json != NULL && out != NULL) || len == 0);
+    for (p = json; p < end; p += 64) {
+        q = p;
+        m = 64;
+        if (end - p < 64) {  // 尾部补空格凑成一块，补的空格随即被删掉
+            memset(buf, ' ', sizeof(buf));
+            memcpy(buf, p, m = end - p);
+            q = buf;
+        }
+        lept_block_scan(q, &b);
+        quote = b.quote & ~lept_block_escaped(b.backslash, &escaped);
+        in_string = lept_prefix_xor(quote) ^ in_string;
+        keep = ~(lept_block_whitespace(q) & ~in_string);
+        in_string = 0 - (in_string >> 63);
+        if (m < 64)  // 尾部只能逐段拷贝，整块压缩会写过输出的结尾
+            keep &= ((uint64_t)1 << m) - 1;
+        else if (keep == ~(uint64_t)0) {  // 整块没有要删的空白
+            memmove(out + n, q, 64);
+            n += 64;
+            continue;
+        } else if (lept_popcount64(keep & ~(keep << 1)) > 4) {  // 缩进后的文本段多而短，整块压缩
+            n += lept_compress_block(out + n, q, keep);
+            continue;
+        }
+        while (keep) {  // 逐段拷贝连续保留的字节
+            int i = lept_ctz64(keep), run = lept_ctz64(~(keep >> i));  // keep 不是全1，~(keep >> i) 不为0
+            memmove(out + n, q + i, run);
+            n += run;
+            keep &= ~((((uint64_t)1 << run) - 1) << i);
+        }
+    }
+    return n;
+}
+
+void lept_prettify(const char* json, size_t len, lept_writer* w) {
+    const char* p = json, *end = json + len, *q;
+    lept_context c;
+    size_t depth = 0;
+    assert((json != NULL || len == 0) && w != NULL);
+    lept_writer_attach(w, &c);
+    while ((p = lept_skip_whitespace(p, end)) < end) {
+        switch (*p) {
+            case '\"':  // 字符串原样拷贝，不闭合时拷贝到结尾
+                q = p + 1;
+                if (lept_skip_string(&q, end) != LEPT_PARSE_OK)
+                    q = end;
+                PUTS(&c, p, q - p);
+                p = q;
+                break;
+            case '[':
+            case '{':
+                lept_context_push(&c, *p);
+                q = lept_skip_whitespace(p + 1, end);
+                if (q < end && *q == *p + 2) {  // 空容器：'[' + 2 == ']'，'{' + 2 == '}'
+                    lept_context_push(&c, *q);
+                    p = q + 1;
+                } else {
+                    if (c.pretty)
+                        lept_stringify_indent(&c, ++depth);
+                    p++;
+                }
+                break;
+            case ']':
+            case '}':
+                if (c.pretty)
+                    lept_stringify_indent(&c, depth ? --depth : 0);
+                lept_context_push(&c, *p++);
+                break;
+            case ',':
+                lept_context_push(&c, *p++);
+                if (c.pretty)
+                    lept_stringify_indent(&c, depth);
+                break;
+            case ':':
+                lept_context_push(&c, *p++);
+                if (c.pretty)
+                    lept_context_push(&c, ' ');
+                break;
+            default:  // 字面量或数字：到下一个分隔符为止
+                for (q = p + 1; q < end && *q != ',' && *q != ']' && *q != '}' && *q != ':' && *q != '\"' && !ISWHITESPACE(*q); q++)
+                    ;
+                PUTS(&c, p, q - p);
+                p = q;
+        }
+    }
+    lept_writer_detach(w, &c, TRUE);
+}
+
+// 按数值比较，整数与浮点数之间也精确比较（不经过有损的转换）
+static int lept_number_equal(const lept_value* lhs, const lept_value* rhs) {
+    const lept_value* t;
+    double d;
+    if (!(lhs->flags & (LEPT_FLAG_INT64 | LEPT_FLAG_UINT64))) {  // 让lhs为整数
+        t = lhs; lhs = rhs; rhs = t;
+    }
+    if (!(lhs->flags & (LEPT_FLAG_INT64 | LEPT_FLAG_UINT64)))
+        return lhs->u.n == rhs->u.n;
+    if (rhs->flags & (LEPT_FLAG_INT64 | LEPT_FLAG_UINT64)) {
+        if ((lhs->flags & LEPT_FLAG_INT64) && lhs->u.i < 0)
+            return (rhs->flags & LEPT_FLAG_INT64) && rhs->u.i == lhs->u.i;
+        if ((rhs->flags & LEPT_FLAG_INT64) && rhs->u.i < 0)
+            return FALSE;
+        return lept_get_uint64(lhs) == lept_get_uint64(rhs);
+    }
+    d = rhs->u.n;  // 浮点数必须是范围内的整数，再按整数比较
+    if (lhs->flags & LEPT_FLAG_INT64)
+        return d >= -9223372036854775808.0 && d < 9223372036854775808.0 && (int64_t)d == lhs->u.i && d == (double)(int64_t)d;
+    return d >= 0.0 && d < 18446744073709551616.0 && (uint64_t)d == lhs->u.u && d == (double)(uint64_t)d;
+}
+
 int lept_is_equal(const lept_value* lhs, const lept_value* rhs) {
     assert(lhs != NULL && rhs != NULL);
     if (lhs->type != rhs->type)
         return FALSE;
+    LEPT_MATERIALIZE(lhs);
+    LEPT_MATERIALIZE(rhs);
     switch (lhs->type) {
         case LEPT_STRING:
-            return lhs->u.s.size == rhs->u.s.size && 
-                    memcmp(lhs->u.s.str, rhs->u.s.str, lhs->u.s.size) == 0;
+            return lept_get_string_length(lhs) == lept_get_string_length(rhs) &&
+                    memcmp(lept_get_string(lhs), lept_get_string(rhs), lept_get_string_length(lhs)) == 0;
         case LEPT_NUMBER:
-            return lhs->u.n == rhs->u.n;
+            return lept_number_equal(lhs, rhs);
         case LEPT_ARRAY:
             if (lhs->u.a.size != rhs->u.a.size)
                 return FALSE;
-            for (size_t i = 0; i < lhs->u.a.size; i++)
-                if (!lept_is_equal(&lhs->u.a.e[i], &rhs->u.a.e[i]))
+            for (size_t i = 0; i < lhs->u.a.size; i++) {
+                lept_value ltmp, rtmp;
+                if (!lept_is_equal(lept_array_at(lhs, i, &ltmp), lept_array_at(rhs, i, &rtmp)))
                     return FALSE;
+            }
             return TRUE;
         case LEPT_OBJECT: {
             if (lhs->u.o.size != rhs->u.o.size)
@@ -847,18 +4379,27 @@ int lept_is_equal(const lept_value* lhs, const lept_value* rhs) {
 
 void lept_copy(lept_value* dst, const lept_value* src) {
     assert(src != NULL && dst != NULL && src != dst);
+    if (src->flags & LEPT_FLAG_LAZY) {  // 未展开的容器只需复制它在输入中的范围
+        lept_free(dst);
+        memcpy(dst, src, sizeof(lept_value));
+        return;
+    }
     switch (src->type) {
         case LEPT_STRING:
-            lept_set_string(dst, src->u.s.str, src->u.s.size);
+            lept_set_string(dst, lept_get_string(src), lept_get_string_length(src));
             break;
         case LEPT_ARRAY:
-            lept_set_array(dst, src->u.a.capacity);
+            if (src->flags & LEPT_FLAG_PACKED) {
+                lept_set_number_array(dst, LEPT_PACKED(src), src->u.a.size);
+                break;
+            }
+            lept_set_array(dst, lept_get_array_capacity(src));
             dst->u.a.size = src->u.a.size;
             for (size_t i = 0; i < src->u.a.size; i++)
                 lept_copy(&dst->u.a.e[i], &src->u.a.e[i]);
             break;
         case LEPT_OBJECT:
-            lept_set_object(dst, src->u.o.capacity);
+            lept_set_object(dst, lept_get_object_capacity(src));
             dst->u.o.size = src->u.o.size;
             for (size_t i = 0; i < src->u.o.size; i++) {
                 dst->u.o.m[i].k = (char*)malloc(src->u.o.m[i].klen + 1);
@@ -867,6 +4408,8 @@ void lept_copy(lept_value* dst, const lept_value* src) {
                 dst->u.o.m[i].klen = src->u.o.m[i].klen;
                 lept_copy(&dst->u.o.m[i].v, &src->u.o.m[i].v);
             }
+            if (dst->u.o.size >= LEPT_OBJECT_HASH_THRESHOLD)
+                lept_object_hash(dst);
             break;
         default:
             lept_free(dst);
@@ -878,7 +4421,7 @@ void lept_copy(lept_value* dst, const lept_value* src) {
 void lept_move(lept_value* dst, lept_value* src) {
     assert(dst != NULL && src != NULL && src != dst);
     lept_free(dst);
-    memcpy(dst, src, sizeof(lept_value));
+    memcpy(dst, src, sizeof(lept_value));  // 短字符串随值一起拷贝
     lept_init(src);
 }
 
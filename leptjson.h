@@ -12,6 +12,8 @@
 #define LEPTJSON_H__
 
 #include <stddef.h>  /* size_t */
+#include <stdint.h>  /* int64_t, uint64_t */
+#include <stdio.h>   /* FILE */
 
 /**
  * @brief: json包含7种数据类型：object, array, number, string, true, false, or null,用枚举表示
@@ -21,18 +23,70 @@ typedef enum { LEPT_NULL, LEPT_FALSE, LEPT_TRUE, LEPT_NUMBER, LEPT_STRING, LEPT_
 typedef struct t_lept_member lept_member;
 typedef struct t_lept_value lept_value;
 
+/*
+ * 定义 LEPT_COMPACT_VALUE 时使用紧凑布局：lept_value 只占16字节（默认布局64位平台上为32字节），
+ * 代价是字符串长度、数组和对象的大小不能超过 UINT32_MAX，短字符串最长10字节。
+ * 库和使用者必须用相同的定义编译。
+ * 紧凑布局按4字节对齐存放指针和double，只在允许非对齐访问的x86/x86-64上可用
+ */
+#ifdef LEPT_COMPACT_VALUE
+#if !defined(__x86_64__) && !defined(__i386__) && !defined(_M_X64) && !defined(_M_IX86)
+#error "LEPT_COMPACT_VALUE requires x86 or x86-64 (4-byte aligned pointers and doubles)"
+#endif
+#define LEPT_SHORT_STRING_MAX (sizeof(char*) + sizeof(uint32_t) - 2)  /* 存放在值内的短字符串的最大长度（64位平台上为10） */
+typedef uint32_t lept_size;
+#else
+#define LEPT_SHORT_STRING_MAX (3 * sizeof(size_t) - 2)  /* 存放在值内的短字符串的最大长度（64位平台上为22） */
+typedef size_t lept_size;
+#endif
+
 /**
  * @brief：json值，JSON 文本被解析为一个树状数据结构
+ * @notes: 紧凑布局中没有capacity字段，堆上数组的容量记录在元素数组之前（见leptjson.c）
  */
+#ifdef LEPT_COMPACT_VALUE
+#pragma pack(push, 4)  /* 指针+uint32载荷之后紧跟类型和标志，不留填充 */
+#endif
 struct t_lept_value{
     union {
+#ifdef LEPT_COMPACT_VALUE
+        struct { lept_member* m; lept_size size; }o;        /* obeject*/
+        struct { lept_value* e; lept_size size; }a;         /* array  */
+#else
         struct { lept_member* m; size_t size, capacity; }o; /* obeject*/
-        struct { char* str; size_t size; }s;                /* string */
         struct { lept_value* e; size_t size, capacity; }a;  /* array  */
+#endif
+        struct { char* str; lept_size size; }s;             /* string */
+        struct { char str[LEPT_SHORT_STRING_MAX + 1]; unsigned char size; }ss; /* short string, LEPT_FLAG_SHORT */
         double n;                                           /* number */
+        int64_t i;                                          /* number, LEPT_FLAG_INT64 */
+        uint64_t u;                                         /* number, LEPT_FLAG_UINT64 */
     } u;
+#ifdef LEPT_COMPACT_VALUE
+    unsigned char type;   /* lept_type */
+#else
     lept_type type;
+#endif
+    unsigned char flags;  /* LEPT_FLAG_* 附加标志位 */
 };
+#ifdef LEPT_COMPACT_VALUE
+#pragma pack(pop)
+#endif
+
+
+/**
+ * @brief：lept_value.flags 标志位，记录载荷内存的归属和数字的存储方式
+ * @notes: 借用的内存（例如来自 lept_arena 或就地解析的输入）不由 lept_free 释放；对借用的数组/对象做增长操作时会先拷贝到堆上
+ *         整数仍然是 LEPT_NUMBER 类型，lept_get_number 照常可用，超过2^53时会损失精度
+ */
+#define LEPT_FLAG_BORROWED      0x01  /* 字符串、元素数组或成员数组不归本值所有（arena或就地解析的缓冲区） */
+#define LEPT_FLAG_KEYS_BORROWED 0x02  /* 对象成员的键不归本值所有 */
+#define LEPT_FLAG_INT64         0x04  /* 数字精确存储在 u.i 中 */
+#define LEPT_FLAG_UINT64        0x08  /* 数字精确存储在 u.u 中（只用于超过INT64_MAX的值） */
+#define LEPT_FLAG_SHORT         0x10  /* 短字符串直接存放在 u.ss 中，不另外分配内存 */
+#define LEPT_FLAG_HASHED        0x20  /* 对象的成员数组之后附有哈希索引（成员较多时自动建立） */
+#define LEPT_FLAG_PACKED        0x40  /* 数组的元素都是数字，紧凑存储为连续的double（见 lept_get_number_array） */
+#define LEPT_FLAG_LAZY          0x80  /* 数组或对象尚未解析，u.s 记录它在输入中的范围（见 lept_parse_lazy） */
 
 
 /**
@@ -44,16 +98,127 @@ struct t_lept_member {
 };
 
 
+typedef struct t_lept_arena_chunk lept_arena_chunk;
+
+/**
+ * @brief：bump 分配器，整篇文档的节点、键和字符串都从中线性分配，最后用 lept_arena_reset 一次性释放
+ */
+typedef struct {
+    lept_arena_chunk* head;  // 当前块（链表头）
+    size_t chunk_size;       // 新块的最小大小
+} lept_arena;
+
+
+typedef struct t_lept_keypool_slot lept_keypool_slot;
+typedef struct t_lept_path_node lept_path_node;
+
+/**
+ * @brief：键的驻留池，相同的键只保存一份，由池中解析的所有对象（可跨多篇文档）共享
+ * @notes: 驻留的键不可修改，池要比引用它的文档活得更久
+ */
+typedef struct {
+    lept_arena arena;         // 键的存储
+    lept_keypool_slot* slots; // 开放寻址哈希表
+    size_t count, capacity;   // 已驻留的键数、槽数
+} lept_keypool;
+
+
+/**
+ * @brief：事件（SAX）接口的回调函数表，解析时不建树，按文本顺序逐个回调
+ * @notes: 不关心的事件置为NULL即可。回调返回TRUE继续解析，返回FALSE则中止，解析结果为LEPT_PARSE_TERMINATED。
+ *         string/key 收到的字符串以'\0'结尾，只在回调期间有效
+ */
+typedef struct {
+    int (*null)(void* user);
+    int (*boolean)(void* user, int b);
+    int (*number)(void* user, double n);
+    int (*string)(void* user, const char* s, size_t len);
+    int (*key)(void* user, const char* s, size_t len);
+    int (*start_array)(void* user);
+    int (*end_array)(void* user, size_t count);    // count: 数组元素个数
+    int (*start_object)(void* user);
+    int (*end_object)(void* user, size_t count);   // count: 对象成员个数
+    int (*int64)(void* user, int64_t i);           // 整数字面量，为NULL时改用number回调
+    int (*uint64)(void* user, uint64_t u);         // 超过INT64_MAX的整数字面量，为NULL时改用number回调
+} lept_handler;
+
+
+/**
+ * @brief：流式输出的写回调，把 buf 中的 len 个字节写出，成功返回TRUE，失败返回FALSE
+ */
+typedef int (*lept_write_fn)(void* user, const char* buf, size_t len);
+
+
+/**
+ * @brief：可重复使用的输出缓冲区，多次生成之间保留容量，稳定后不再分配内存
+ * @notes: buf 以'\0'结尾，len 不含'\0'；下一次生成会覆盖上一次的输出
+ */
+typedef struct {
+    char* buf;
+    size_t size, len;  // 容量、输出长度
+    int flags;         // 输出格式（LEPT_PRETTY_*），0 为紧凑输出
+} lept_writer;
+
+
 /**
  * @brief：
  */
 typedef struct {
     const char* json;
+    const char* end;  // 输入末尾，解析不会越过它
     char* stack;
     size_t size, top; // 栈最大值、顶层位置
+    lept_arena* arena; // 非NULL时节点、键和字符串从arena分配
+    int insitu;        // 非0时字符串在输入缓冲区内就地解码
+    lept_keypool* keys; // 非NULL时对象的键从池中驻留
+    int lazy;          // 非0时数组和对象只记录范围，访问时再解析
+    const lept_path_node* proj; // 非NULL时只保留投影路径上的值，其余跳过
+    const lept_handler* handler; // 事件解析的回调函数表
+    void* user;                  // 传给回调的用户数据
+    lept_write_fn write;         // 非NULL时生成器分批把缓冲区交给它
+    int pretty;                  // 生成器的输出格式（LEPT_PRETTY_*），0 为紧凑输出
+    int fixed;                   // 非0时栈是调用者提供的缓冲区，不能realloc；放不下时 top 记为 size + 1
 } lept_context;
 
 
+/**
+ * @brief：增量（推送式）解析器，输入可以在任意字节处切分，状态跨块保存
+ * @notes: 字段是内部状态，调用者不要直接访问；初始化后不要移动该结构体
+ */
+typedef struct {
+    lept_context c;       // c.stack：容器帧，以及其上未完成的字符串或数字；c.handler/c.user：事件回调
+    lept_context dom;     // 建树模式下暂存已完成的值
+    int state, ret;       // 状态机状态、出错后保持的错误码
+    int is_key;           // 当前字符串是否为对象的键
+    size_t head;          // 未完成的字符串/数字在 c.stack 中的起点
+    size_t depth;         // 容器嵌套深度
+    unsigned u, hi, hex;  // \u 转义：正在累积的码点、高代理项、已读的十六进制位数
+    const char* literal;  // 正在匹配的 true/false/null
+    size_t matched;       // 已匹配的字节数
+} lept_stream;
+
+
+/**
+ * @brief：预编译的 JSON Pointer 中的一个token
+ */
+typedef struct {
+    const char* key;  // 解码后的token（~1 => '/'，~0 => '~'），以'\0'结尾
+    size_t len;
+    size_t index;     // token 是数组下标时的值，否则为 LEPT_KEY_NOT_EXIST
+    uint32_t hash;    // 键的哈希值，查找哈希索引时不再重新计算
+    size_t hint;      // 上一次在对象中找到该键的位置，同结构的文档可以直接命中
+} lept_pointer_token;
+
+/**
+ * @brief：预编译的 JSON Pointer（RFC 6901），编译一次后可以对多篇文档求值
+ * @notes: 求值会更新 token 的位置缓存，同一个指针不要在多个线程中同时使用
+ */
+typedef struct {
+    lept_pointer_token* tokens;  // 与解码后的键在同一块内存里
+    size_t count;
+} lept_pointer;
+
+
 /**
  * @brief：接口调用返回结果
  */
@@ -72,11 +237,21 @@ enum {
     LEPT_PARSE_MISS_KEY,                     // 缺少键
     LEPT_PARSE_MISS_COLON,                   // 缺少冒号
     LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET,  // 缺少逗号或者右花括号
-    LEPT_STRINGIFY_OK
+    LEPT_STRINGIFY_OK,
+    LEPT_PARSE_TERMINATED,                   // 事件回调要求中止解析
+    LEPT_PARSE_TOO_LARGE,                    // 字符串或数组/对象的长度超过 lept_size 的范围（紧凑布局中为32位）
+    LEPT_PARSE_INVALID_PATH,                 // 投影路径不是空字符串，也不以'/'开头，或者'~'之后不是'0'/'1'（lept_parse_projected）
+    LEPT_STRINGIFY_WRITE_FAILED,             // 流式输出的写回调返回失败
+    LEPT_STRINGIFY_BUFFER_TOO_SMALL          // 调用者提供的缓冲区放不下输出（lept_stringify_buffer）
 };
 
 #define LEPT_KEY_NOT_EXIST ((size_t)-1)
-#define lept_init(v) do { (v)->type = LEPT_NULL; } while (0)
+
+/* 美化输出的格式，可以组合；都不指定时为紧凑输出。对象的冒号之后加一个空格，空数组/对象仍写作 []/{} */
+#define LEPT_PRETTY_INDENT(n)   ((n) & 0xFF)  /* 每层缩进 n（0~255）个空格，或 n 个制表符 */
+#define LEPT_PRETTY_TABS        0x100         /* 用制表符缩进 */
+#define LEPT_PRETTY_CRLF        0x200         /* 换行用 "\r\n"，默认 "\n" */
+#define lept_init(v) do { (v)->type = LEPT_NULL; (v)->flags = 0; } while (0)
 #define TRUE 1
 #define FALSE 0
 
@@ -91,6 +266,234 @@ enum {
 int lept_parse(lept_value* v, const char* json);
 
 
+/**
+ * @brief 解析恰好 len 字节的JSON文本，不要求以'\0'结尾，也不会读取末尾之后的字节
+ * @notes: 可以直接解析接收缓冲区或mmap的文件，无需拷贝后补'\0'
+ * 
+ * @param [out] v: 程序可读结构体
+ * @param [in] json: 文本起始位置
+ * @param [in] len: 文本字节数
+ * @return int : 解析结果
+ */
+int lept_parse_n(lept_value* v, const char* json, size_t len);
+
+
+/**
+ * @brief 就地（破坏性）解析：字符串在 json 缓冲区内就地反转义，字符串值和对象的键直接指向缓冲区，不再拷贝
+ * @notes: 解析后缓冲区内容被改写；在释放得到的树之前，缓冲区必须保持有效
+ * 
+ * @param [out] v: 程序可读结构体
+ * @param [in,out] json: 可写的C风格字符串
+ * @return int : 解析结果
+ */
+int lept_parse_insitu(lept_value* v, char* json);
+
+
+/**
+ * @brief 事件（SAX）解析：沿用递归下降文法，但不建树，每个值通过 handler 中的回调交给调用者
+ * @notes: 出错前已经发出的事件不会撤回；内存占用只与嵌套深度和最长的字符串有关
+ * 
+ * @param [in] json: 文本起始位置
+ * @param [in] len: 文本字节数
+ * @param [in] handler: 回调函数表
+ * @param [in] user: 透传给回调的用户数据
+ * @return int : 解析结果
+ */
+int lept_parse_sax(const char* json, size_t len, const lept_handler* handler, void* user);
+
+
+/**
+ * @brief 初始化增量解析器
+ * 
+ * @param [out] ps: 解析器
+ * @param [in] handler: 事件回调；为NULL时建树，由 lept_stream_finish 交出
+ * @param [in] user: 透传给回调的用户数据
+ */
+void lept_stream_init(lept_stream* ps, const lept_handler* handler, void* user);
+
+
+/**
+ * @brief 送入下一块输入，可在字符串、转义序列、\uXXXX 或数字中间切分
+ * 
+ * @param ps 
+ * @param [in] chunk: 本块起始位置，调用返回后即可复用
+ * @param [in] len: 本块字节数
+ * @return int : 出错时返回错误码，之后的调用都返回同一错误
+ */
+int lept_stream_feed(lept_stream* ps, const char* chunk, size_t len);
+
+
+/**
+ * @brief 输入结束，检查文本是否完整
+ * 
+ * @param ps 
+ * @param [out] v: 建树模式下得到的JSON值，可为NULL
+ * @return int : 解析结果，与对完整文本调用 lept_parse 相同
+ */
+int lept_stream_finish(lept_stream* ps, lept_value* v);
+
+
+/**
+ * @brief 释放解析器（包括出错或中途放弃时暂存的值）
+ * 
+ * @param ps 
+ */
+void lept_stream_free(lept_stream* ps);
+
+
+/**
+ * @brief 初始化arena
+ * 
+ * @param [out] a: arena
+ * @param [in] chunk_size: 每块的最小字节数，0 表示使用默认值
+ */
+void lept_arena_init(lept_arena* a, size_t chunk_size);
+
+
+/**
+ * @brief 从arena中分配内存（按 8 字节对齐），内存在 lept_arena_reset/lept_arena_free 之前一直有效
+ * 
+ * @param a 
+ * @param size 
+ * @return void* 
+ */
+void* lept_arena_alloc(lept_arena* a, size_t size);
+
+
+/**
+ * @brief 一次性释放arena分配的全部内存，保留最大的一块供下一篇文档复用
+ * 
+ * @param a 
+ */
+void lept_arena_reset(lept_arena* a);
+
+
+/**
+ * @brief 归还arena的全部内存
+ * 
+ * @param a 
+ */
+void lept_arena_free(lept_arena* a);
+
+
+/**
+ * @brief 解析JSON，所有节点、键和字符串都从arena分配
+ * @notes: 得到的树可以用全部访问接口读写；整篇文档随 lept_arena_reset 释放，无需逐个 lept_free
+ * 
+ * @param [out] v: 程序可读结构体
+ * @param [in] json: 字符串指针
+ * @param [in] a: arena
+ * @return int : 解析结果
+ */
+int lept_parse_arena(lept_value* v, const char* json, lept_arena* a);
+
+
+/**
+ * @brief 跳过一个JSON值（包括它之前的空白），不解析也不分配内存
+ * @notes: 只跟踪字符串（含转义）和括号深度，不检查值的内容；数组和对象按64字节一块用位掩码配对括号。
+ *         字面量和数字跳到下一个分隔符为止
+ * 
+ * @param [in] json: 输入
+ * @param [in] len: 输入长度
+ * @param [out] end: 值之后的位置（相对 json 的偏移）
+ * @return int : LEPT_PARSE_OK；没有值、字符串或括号不闭合时返回对应的错误码
+ */
+int lept_skip_value(const char* json, size_t len, size_t* end);
+
+
+/**
+ * @brief 只校验JSON文本，不建树也不分配内存
+ * @notes: 文法和错误码与 lept_parse_n 完全相同（包括数值超出double范围），只是不建树，也就不报告 LEPT_PARSE_TOO_LARGE；
+ *         嵌套层数用位图记录，字符串和空白用与解析相同的SIMD扫描
+ * 
+ * @param [in] json: 文本起始位置，不要求以'\0'结尾
+ * @param [in] len: 文本字节数
+ * @param [out] err_offset: 出错时为出错位置相对 json 的偏移，成功时不修改；可以为NULL
+ * @return int : 与 lept_parse_n 对同一文本的解析结果相同
+ */
+int lept_validate(const char* json, size_t len, size_t* err_offset);
+
+
+/**
+ * @brief 懒惰解析JSON：数组和对象只配对括号、记录在输入中的范围，第一次被访问时才解析（每次展开一层）
+ * @notes: json 必须在 v 释放之前一直有效且不被修改；访问接口不变。
+ *         解析时用 lept_validate 扫描一遍整个文本，错误码与 lept_parse 相同，展开时不会再出错；
+ *         根容器的范围由此得到，不再配对括号。之后每展开一层都要重新扫描它的内容来配对子容器的括号，
+ *         逐层访问整个文档的代价约为 嵌套深度 × 文本大小。
+ *         展开会改写值，包括 lept_get_array_size 等接受 const 指针的读取接口：懒惰解析的文档不能被多个线程同时读取
+ * 
+ * @param [out] v: 程序可读结构体
+ * @param [in] json: 字符串指针
+ * @return int : 解析结果
+ */
+int lept_parse_lazy(lept_value* v, const char* json);
+
+
+/**
+ * @brief 展开懒惰解析的数组或对象（一层），其他值不变
+ * 
+ * @param [in] v: json值
+ * @return int : 解析结果；只有输入在 lept_parse_lazy 之后被修改时才会出错，此时 v 成为同类型的空容器
+ */
+int lept_materialize(lept_value* v);
+
+
+/**
+ * @brief 初始化键池
+ * 
+ * @param [out] p: 键池
+ */
+void lept_keypool_init(lept_keypool* p);
+
+
+/**
+ * @brief 归还键池的全部内存，之后引用池中键的文档都不能再访问
+ * 
+ * @param p 
+ */
+void lept_keypool_free(lept_keypool* p);
+
+
+/**
+ * @brief 驻留一个键：池中已有相同内容时返回已有的副本，否则拷贝一份（以'\0'结尾）
+ * 
+ * @param [in] p: 键池
+ * @param [in] key: 键
+ * @param [in] len: 键的长度
+ * @return const char* : 池中的键，相同内容总是返回同一个指针
+ */
+const char* lept_keypool_intern(lept_keypool* p, const char* key, size_t len);
+
+
+/**
+ * @brief 解析JSON，对象的键全部从键池驻留，相同的键共享同一个缓冲区
+ * @notes: 值仍按 lept_parse 的方式分配，用 lept_free 释放；查找时先比较指针，
+ *         用 lept_keypool_intern 得到的键查找可以省去逐字节比较
+ * 
+ * @param [out] v: 程序可读结构体
+ * @param [in] json: 字符串指针
+ * @param [in] p: 键池
+ * @return int : 解析结果
+ */
+int lept_parse_keypool(lept_value* v, const char* json, lept_keypool* p);
+
+
+/**
+ * @brief 投影解析：只建立给定路径上的值，其余的值跳过，不分配内存也不检查内容
+ * @notes: 路径的写法同JSON Pointer（"/user/id"，~1 表示'/'，~0 表示'~'），"*" 匹配任意键或数组下标，
+ *         空字符串表示整个文档。路径上的对象只保留匹配的成员，数组只保留匹配的元素（下标因此会变化）；
+ *         路径中间遇到的标量不保留。路径终点的值完整解析。根是标量时照常返回。
+ *         任何一条路径不合法时返回 LEPT_PARSE_INVALID_PATH，不解析json，v为null
+ * 
+ * @param [out] v: 程序可读结构体
+ * @param [in] json: 字符串指针
+ * @param [in] paths: 路径数组
+ * @param [in] npaths: 路径个数
+ * @return int : 解析结果
+ */
+int lept_parse_projected(lept_value* v, const char* json, const char* const* paths, size_t npaths);
+
+
 /**
  * @brief 清空内部分配内存
  * 
@@ -189,6 +592,36 @@ double lept_get_number(const lept_value* v);
 void lept_set_number(lept_value* v, double n);
 
 
+/**
+ * @brief 数字是否精确存储为有符号/无符号64位整数（解析整数字面量或 lept_set_int64/lept_set_uint64 的结果）
+ * 
+ * @param [in] v: json值
+ * @return int 
+ */
+int lept_is_int64(const lept_value* v);
+int lept_is_uint64(const lept_value* v);
+
+
+/**
+ * @brief 获取整数
+ * 
+ * @param [in] v: json值
+ * @return int64_t : 浮点数向零取整；值超出范围时结果未定义
+ */
+int64_t lept_get_int64(const lept_value* v);
+uint64_t lept_get_uint64(const lept_value* v);
+
+
+/**
+ * @brief 设置整数，精确存储，输出时按整数格式化
+ * 
+ * @param [out] v: json值
+ * @param i 
+ */
+void lept_set_int64(lept_value* v, int64_t i);
+void lept_set_uint64(lept_value* v, uint64_t u);
+
+
 /**
  * @brief 设置字符串
  * 
@@ -228,6 +661,7 @@ size_t lept_get_array_size(const lept_value* v);
 
 /**
  * @brief 获取数组的元素
+ * @notes: 返回的元素可以改写，紧凑存储的数字数组因此先转换回一般形式；只读取数字时用 lept_get_array_number
  * 
  * @param [in] v: json值  
  * @param index 
@@ -236,6 +670,51 @@ size_t lept_get_array_size(const lept_value* v);
 lept_value* lept_get_array_element(const lept_value* v, size_t index);
 
 
+/**
+ * @brief 读取数字数组的元素，不改变数组（紧凑存储时不转换）
+ * 
+ * @param [in] v: json值（数组）
+ * @param index: 元素须为数字
+ * @return double 
+ */
+double lept_get_array_number(const lept_value* v, size_t index);
+
+
+/**
+ * @brief 批量读取纯数字数组
+ * @notes: 解析时元素较多的纯数字数组直接存为连续的double；其他纯数字数组在首次调用时转换，之前取得的元素指针失效。
+ *         lept_get_array_element 等返回元素指针的接口会把数组转换回一般形式，之后 *n 失效。
+ *         紧凑存储只保留double：按元素读取时2^53以内的整数值读作整数（lept_is_int64 为真），写作 3.0 的元素也是如此
+ * 
+ * @param [in] v: json值  
+ * @param [out] n: 连续的double
+ * @param [out] len: 元素个数
+ * @return int : 数组含有非数字元素（或超过2^53的整数）时返回FALSE，数组不变；
+ *               arena中的数组在arena内就地转换，不分配内存
+ */
+int lept_get_number_array(const lept_value* v, const double** n, size_t* len);
+
+
+/**
+ * @brief 设置为纯数字数组，拷贝 len 个double
+ * 
+ * @param [in] v: json值  
+ * @param [in] n: 
+ * @param [in] len: 
+ */
+void lept_set_number_array(lept_value* v, const double* n, size_t len);
+
+
+/**
+ * @brief 在数组末尾批量追加数字，纯数字数组保持紧凑存储
+ * 
+ * @param [in] v: json值（数组）
+ * @param [in] n: 
+ * @param [in] len: 
+ */
+void lept_append_number_array(lept_value* v, const double* n, size_t len);
+
+
 /**
  * @brief 设置数组初始容量
  * 
@@ -356,6 +835,8 @@ lept_value* lept_get_object_value(const lept_value* v, size_t index);
 
 /**
  * @brief 按key寻找obj的key
+ * @notes: 成员数达到 LEPT_OBJECT_HASH_THRESHOLD 的对象通过哈希索引查找。索引由解析、拷贝和 lept_set_object_value 建立，
+ *         查找本身不修改v，不会使已取得的成员指针失效；懒惰解析的值除外（见 lept_parse_lazy）
  * 
  * @param v 
  * @param key 
@@ -365,6 +846,19 @@ lept_value* lept_get_object_value(const lept_value* v, size_t index);
 size_t lept_find_object_index(const lept_value* v, const char* key, size_t klen);
 
 
+/**
+ * @brief 带位置缓存的查找：先比较 *hint 处的键，不符时再按 lept_find_object_index 查找，找到后更新 *hint
+ * @notes: 处理大量键顺序相同的记录时，每个字段保存一个 hint（初始为0），查找基本只需一次比较
+ * 
+ * @param [in] v: 对象
+ * @param [in] key: 键
+ * @param [in] klen: 键的长度
+ * @param [in,out] hint: 上一次找到该键的位置
+ * @return size_t : 成员下标，不存在时返回 LEPT_KEY_NOT_EXIST（hint 不变）
+ */
+size_t lept_find_object_index_hint(const lept_value* v, const char* key, size_t klen, size_t* hint);
+
+
 /**
  * @brief 按key寻找obj的value
  * 
@@ -449,8 +943,51 @@ void lept_remove_object_value_key(lept_value* v, const char* key, size_t klen);
 void lept_clear_object(lept_value* v);
 
 
+/**
+ * @brief 编译 JSON Pointer：切分token、解码 ~0/~1、计算键的哈希值和数组下标
+ * 
+ * @param [out] p: 编译结果，用 lept_pointer_free 释放
+ * @param [in] path: 指针，""表示整个文档，否则以'/'开头
+ * @return int : TRUE；格式错误（不以'/'开头，或 '~' 之后不是 0/1）时返回FALSE，p 不需要释放
+ */
+int lept_pointer_compile(lept_pointer* p, const char* path);
+
+
+/**
+ * @brief 释放编译好的指针
+ * 
+ * @param p 
+ */
+void lept_pointer_free(lept_pointer* p);
+
+
+/**
+ * @brief 求指针指向的值
+ * @notes: 对象先按上一次命中的位置比较键，不符时再查找；懒惰解析的容器在路过时展开，
+ *         紧凑存储的数字数组在取元素时转换回一般数组
+ * 
+ * @param [in] p: 编译好的指针
+ * @param [in] v: 文档
+ * @return lept_value* : 指向的值，不存在时返回NULL
+ */
+lept_value* lept_pointer_get(lept_pointer* p, const lept_value* v);
+
+
+/**
+ * @brief 求指针指向的值，路径上缺少的成员随之创建，返回的值由调用者改写
+ * @notes: 缺少的成员创建为null，值为null的中间结点变为空对象（下一个token为 "-" 时为空数组）；
+ *         数组的token为 "-" 或等于数组长度时追加一个元素
+ * 
+ * @param [in] p: 编译好的指针
+ * @param [in] v: 文档
+ * @return lept_value* : 指向的值；路径经过标量或数组下标越界时返回NULL
+ */
+lept_value* lept_pointer_set(lept_pointer* p, lept_value* v);
+
+
 /**
  * @brief 生成JSON字符串
+ * @notes: 无穷大和NaN没有JSON表示，输出为 null
  * 
  * @param [in] v: json值
  * @param [out] json: 输出C字符串 
@@ -459,4 +996,113 @@ void lept_clear_object(lept_value* v);
  */
 int lept_stringify(const lept_value* v, char** json, size_t* length);
 
+
+/**
+ * @brief 流式生成JSON：写入固定大小的缓冲区，用了一半以上时交给写回调
+ * @notes: 内存占用与文档大小无关：缓冲区只在单次写入超过剩余空间时增长，长字符串分段转义
+ * 
+ * @param [in] v: json值
+ * @param [in] write: 写回调
+ * @param [in] user: 传给写回调的用户数据
+ * @param [in] bufsize: 缓冲区大小，0 表示 LEPT_STRINGIFY_BUFFER_SIZE（默认64KB）
+ * @param [in] flags: 格式（LEPT_PRETTY_*），0 时输出与 lept_stringify 相同
+ * @return int: LEPT_STRINGIFY_OK；写回调失败时返回 LEPT_STRINGIFY_WRITE_FAILED，已写出的内容不撤回
+ */
+int lept_stringify_to(const lept_value* v, lept_write_fn write, void* user, size_t bufsize, int flags);
+
+
+/**
+ * @brief 流式生成JSON到文件，同 lept_stringify_to
+ * 
+ * @param [in] v: json值
+ * @param [in] fp: 打开的文件
+ * @param [in] flags: 格式（LEPT_PRETTY_*），0 为紧凑输出
+ * @return int: 调用结果，fwrite 失败时返回 LEPT_STRINGIFY_WRITE_FAILED
+ */
+int lept_stringify_file(const lept_value* v, FILE* fp, int flags);
+
+
+/**
+ * @brief 初始化输出缓冲区
+ * 
+ * @param [out] w: 输出缓冲区
+ */
+void lept_writer_init(lept_writer* w);
+
+
+/**
+ * @brief 释放输出缓冲区
+ * 
+ * @param w 
+ */
+void lept_writer_free(lept_writer* w);
+
+
+/**
+ * @brief 生成JSON到可重复使用的缓冲区，结果在 w->buf / w->len
+ * @notes: 格式由 w->flags 指定，为0时输出与 lept_stringify 相同
+ * 
+ * @param [in] v: json值
+ * @param [in,out] w: 输出缓冲区，容量不够时扩大并保留给下一次
+ * @return int: 调用结果
+ */
+int lept_stringify_writer(const lept_value* v, lept_writer* w);
+
+
+/**
+ * @brief 生成带缩进和换行的JSON，用于调试输出
+ * 
+ * @param [in] v: json值
+ * @param [out] json: 输出C字符串，由调用者 free
+ * @param [out] length: 字符串长度，可以为NULL
+ * @param [in] flags: 格式，如 LEPT_PRETTY_INDENT(2)、LEPT_PRETTY_TABS | LEPT_PRETTY_CRLF
+ * @return int: 调用结果
+ */
+int lept_stringify_pretty(const lept_value* v, char** json, size_t* length, int flags);
+
+
+/**
+ * @brief 计算紧凑输出的准确长度（不含'\0'），不分配内存
+ * @notes: 数字要完整格式化一次才知道长度，代价与生成相当；懒惰解析的容器会被展开
+ * 
+ * @param [in] v: json值
+ * @return size_t : 输出的字节数
+ */
+size_t lept_stringify_size(const lept_value* v);
+
+
+/**
+ * @brief 生成JSON到调用者提供的缓冲区，不分配内存
+ * 
+ * @param [in] v: json值
+ * @param [out] buf: 输出缓冲区
+ * @param [in] size: 缓冲区大小，需要 lept_stringify_size(v) + 1 字节
+ * @param [out] length: 输出长度（不含'\0'），可以为NULL
+ * @return int: 调用结果；放不下输出和结尾的'\0'时返回 LEPT_STRINGIFY_BUFFER_TOO_SMALL，buf 的内容不确定
+ */
+int lept_stringify_buffer(const lept_value* v, char* buf, size_t size, size_t* length);
+
+
+/**
+ * @brief 删除JSON文本中字符串之外的空白，不建树也不检查语法
+ * @notes: 按64字节一块用位掩码区分字符串内外，整块没有空白时直接拷贝；out 可以等于 json（就地压缩）
+ * 
+ * @param [in] json: 输入
+ * @param [in] len: 输入长度
+ * @param [out] out: 输出，至少 len 字节，不以'\0'结尾
+ * @return size_t : 输出长度
+ */
+size_t lept_minify(const char* json, size_t len, char* out);
+
+
+/**
+ * @brief 按 w->flags 的格式重新排版JSON文本，不建树也不检查语法，输入有误时输出也照原样保留错误
+ * @notes: 输出与解析后用 lept_stringify_writer 生成的格式相同，但数字和字符串保持原文
+ * 
+ * @param [in] json: 输入
+ * @param [in] len: 输入长度
+ * @param [in,out] w: 输出缓冲区，结果在 w->buf / w->len
+ */
+void lept_prettify(const char* json, size_t len, lept_writer* w);
+
 #endif /* LEPTJSON_H__ */
\ No newline at end of file
@@ -11,6 +11,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <math.h>    /* HUGE_VAL */
 #include "leptjson.h"
 
 static int main_ret = 0;    // 程序返回值
@@ -49,6 +50,7 @@ static int test_pass = 0;   // 成功测试条目
         lept_init(&v);\
         EXPECT_EQ_INT(expect, lept_parse(&v, json));\
         EXPECT_EQ_INT(types, lept_get_type(&v));\
+        EXPECT_EQ_INT(expect, lept_validate(json, strlen(json), NULL));\
         lept_free(&v);\
     } while (0)
 
@@ -64,6 +66,7 @@ static int test_pass = 0;   // 成功测试条目
         EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, json));\
         EXPECT_EQ_INT(LEPT_NUMBER, lept_get_type(&v));\
         EXPECT_EQ_DOUBLE(nums, lept_get_number(&v));\
+        EXPECT_EQ_INT(LEPT_PARSE_OK, lept_validate(json, strlen(json), NULL));\
         lept_free(&v);\
     } while (0)
 
@@ -74,6 +77,7 @@ static int test_pass = 0;   // 成功测试条目
         EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, json));\
         EXPECT_EQ_INT(LEPT_STRING, lept_get_type(&v));\
         EXPECT_EQ_STRING(str, lept_get_string(&v), lept_get_string_length(&v));\
+        EXPECT_EQ_INT(LEPT_PARSE_OK, lept_validate(json, strlen(json), NULL));\
         lept_free(&v);\
     } while (0)
 
@@ -87,6 +91,7 @@ static int test_pass = 0;   // 成功测试条目
         EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, json));\
         EXPECT_EQ_INT(LEPT_STRINGIFY_OK, lept_stringify(&v, &json2, &length));\
         EXPECT_EQ_STRING(json, json2, length);\
+        EXPECT_EQ_SIZE_T(length, lept_stringify_size(&v));\
         lept_free(&v);\
         free(json2);\
     } while(0)
@@ -153,6 +158,139 @@ static void test_parse_number() {
     TEST_NUMBER(-2.2250738585072014e-308, "-2.2250738585072014e-308");
     TEST_NUMBER( 1.7976931348623157e+308, "1.7976931348623157e+308");  /* Max double */
     TEST_NUMBER(-1.7976931348623157e+308, "-1.7976931348623157e+308");
+    /* 不经过快速路径、需要精确计算的情况 */
+    TEST_NUMBER(9007199254740992.0, "9007199254740993"); /* 2^53 + 1, halfway, round to even */
+    TEST_NUMBER(9007199254740996.0, "9007199254740995");
+    TEST_NUMBER(2.2250738585072011e-308, "2.2250738585072011e-308");
+    TEST_NUMBER(4.9406564584124654e-324, "2.4703282292062328e-324");  /* just above half of minimum denormal */
+    TEST_NUMBER(0.0, "2.4703282292062327e-324");
+    TEST_NUMBER(1.7976931348623157e+308, "1.7976931348623158e+308");  /* rounds down to max double */
+    TEST_NUMBER(7.0420557077594588e+306, "7.0420557077594588e+306");
+    TEST_NUMBER(1.0, "1.00000000000000011102230246251565404236316680908203125"); /* 1 + 2^-53, halfway */
+    TEST_NUMBER(1.0000000000000002, "1.00000000000000011102230246251565404236316680908203126");
+    TEST_NUMBER(0.1, "0.1000000000000000000000000000000000000000000000000000000000000000000000000000001");
+    TEST_NUMBER(123456789012345678901234567890.0, "123456789012345678901234567890");
+    TEST_NUMBER(1e23, "1e23");
+    TEST_NUMBER(1e22, "0.00000000000000000000000000000000000000000000001e69");
+}
+
+
+#define TEST_INT64(expect, json)\
+    do {\
+        lept_value v;\
+        lept_init(&v);\
+        EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, json));\
+        EXPECT_TRUE(lept_is_int64(&v));\
+        EXPECT_TRUE(lept_get_int64(&v) == (expect));\
+        lept_free(&v);\
+    } while(0)
+
+
+/**
+ * @brief 测试整数字面量：在64位范围内的精确存储为整数，其余仍是浮点数
+ * 
+ */
+static void test_parse_int64() {
+    lept_value v;
+    TEST_INT64(0, "0");
+    TEST_INT64(-1, "-1");
+    TEST_INT64(123, "123");
+    TEST_INT64(9007199254740993LL, "9007199254740993");  /* 2^53 + 1 */
+    TEST_INT64(INT64_MAX, "9223372036854775807");
+    TEST_INT64(INT64_MIN, "-9223372036854775808");
+
+    lept_init(&v);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, "18446744073709551615"));
+    EXPECT_TRUE(lept_is_uint64(&v));
+    EXPECT_TRUE(lept_get_uint64(&v) == UINT64_MAX);
+    EXPECT_EQ_DOUBLE(18446744073709551615.0, lept_get_number(&v));
+
+    /* 超出范围、有小数或指数部分、-0 都是浮点数 */
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, "18446744073709551616"));
+    EXPECT_FALSE(lept_is_uint64(&v));
+    EXPECT_EQ_DOUBLE(18446744073709551616.0, lept_get_number(&v));
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, "-9223372036854775809"));
+    EXPECT_FALSE(lept_is_int64(&v));
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, "100000000000000000000000"));
+    EXPECT_FALSE(lept_is_int64(&v) || lept_is_uint64(&v));
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, "1.0"));
+    EXPECT_FALSE(lept_is_int64(&v));
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, "1e2"));
+    EXPECT_FALSE(lept_is_int64(&v));
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, "-0"));
+    EXPECT_FALSE(lept_is_int64(&v));
+    lept_free(&v);
+}
+
+
+/* 与strtod逐位比较；strtod溢出时应返回LEPT_PARSE_NUMBER_TOO_BIG */
+static int number_matches_strtod(const char* json) {
+    lept_value v;
+    double expect = strtod(json, NULL), actual;
+    int ret, ok;
+    lept_init(&v);
+    ret = lept_parse(&v, json);
+    if (expect == HUGE_VAL || expect == -HUGE_VAL)
+        ok = ret == LEPT_PARSE_NUMBER_TOO_BIG;
+    else
+        ok = ret == LEPT_PARSE_OK && (actual = lept_get_number(&v), memcmp(&expect, &actual, sizeof(double)) == 0);
+    if (!ok)
+        fprintf(stderr, "number mismatch: %s\n", json);
+    lept_free(&v);
+    return ok;
+}
+
+static unsigned long long random_state = 88172645463325252ULL;
+
+static unsigned long long random_next() {
+    random_state ^= random_state << 13;
+    random_state ^= random_state >> 7;
+    random_state ^= random_state << 17;
+    return random_state;
+}
+
+
+/**
+ * @brief 随机测试数字转换：随机的double、随机的数字串、两个相邻double的中点附近
+ * 
+ */
+static void test_parse_number_random() {
+    char json[128];
+    size_t i, j, n, dot;
+    int bad = 0;
+    double d, next;
+    long double mid;
+    for (i = 0; i < 50000; i++) {
+        unsigned long long bits = random_next();
+        memcpy(&d, &bits, sizeof(d));
+        if (d != d || d == HUGE_VAL || d == -HUGE_VAL)
+            continue;
+        sprintf(json, "%.*g", (int)(15 + i % 3), d);
+        bad += !number_matches_strtod(json);
+
+        /* 两个相邻double的中点，以及最低几位的扰动 */
+        bits++;
+        memcpy(&next, &bits, sizeof(next));  /* 绝对值更大的相邻double */
+        mid = ((long double)d + (long double)next) / 2;
+        sprintf(json, "%.*Le", (int)(17 + i % 20), mid);
+        bad += !number_matches_strtod(json);
+
+        /* 1~40位数字，随机小数点位置和指数 */
+        n = 1 + random_next() % 40;
+        dot = random_next() % (n + 1);
+        j = 0;
+        if (random_next() % 2)
+            json[j++] = '-';
+        json[j++] = (char)('1' + random_next() % 9);
+        for (; j < n + 1; j++) {
+            if (j == dot + 1)
+                json[j++] = '.';
+            json[j] = (char)('0' + random_next() % 10);
+        }
+        sprintf(json + j, "e%d", (int)(random_next() % 700) - 360);
+        bad += !number_matches_strtod(json);
+    }
+    EXPECT_EQ_INT(0, bad);
 }
 
 
@@ -215,6 +353,53 @@ static void test_parse_invalid_str() {
 }
 
 
+/**
+ * @brief 测试长字符串和长空白：特殊字节出现在向量块内、块边界和尾部的每个位置
+ * 
+ */
+static void test_parse_long_run() {
+    char json[128], expect[128], insitu[128];
+    lept_value v;
+    size_t n, i, j;
+    lept_init(&v);
+    for (n = 0; n < 72; n++) {
+        for (i = 0; i <= n; i++) {
+            /* 普通字节中含有高位为1的字节，第i个位置是转义 */
+            json[0] = '\"';
+            for (j = 0; j < n; j++)
+                json[1 + j] = expect[j] = (j % 3 == 0) ? '\xE9' : (char)('a' + j % 26);
+            memmove(json + 1 + i + 2, json + 1 + i, n - i);
+            json[1 + i] = '\\';
+            json[2 + i] = 'n';
+            memmove(expect + i + 1, expect + i, n - i);
+            expect[i] = '\n';
+            json[n + 3] = '\"';
+            EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_n(&v, json, n + 4));
+            EXPECT_TRUE(lept_get_string_length(&v) == n + 1 && memcmp(lept_get_string(&v), expect, n + 1) == 0);
+            lept_free(&v);
+            memcpy(insitu, json, n + 4);
+            insitu[n + 4] = '\0';
+            EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_insitu(&v, insitu));
+            EXPECT_TRUE(lept_get_string_length(&v) == n + 1 && memcmp(lept_get_string(&v), expect, n + 1) == 0);
+            lept_free(&v);
+
+            /* 第i个位置是控制字符 */
+            json[1 + i] = '\x1F';
+            EXPECT_EQ_INT(LEPT_PARSE_INVALID_STRING_CHAR, lept_parse_n(&v, json, n + 4));
+
+            /* 第i个字节之前是空白 */
+            for (j = 0; j < i; j++)
+                json[j] = " \t\n\r"[j % 4];
+            json[i] = '1';
+            for (j = i + 1; j <= n; j++)
+                json[j] = ' ';
+            EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_n(&v, json, n + 1));
+            EXPECT_EQ_DOUBLE(1.0, lept_get_number(&v));
+        }
+    }
+}
+
+
 /**
  * @brief ：无效unicode编码
  * 
@@ -299,6 +484,8 @@ static void test_parse_invalid_array() {
     TEST_ERROR(LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET, "[1}");
     TEST_ERROR(LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET, "[1 2");
     TEST_ERROR(LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET, "[[]");
+    TEST_ERROR(LEPT_PARSE_INVALID_VALUE, "[1,[x]]");  /* 嵌套出错时外层的栈内容要正确弹出 */
+    TEST_ERROR(LEPT_PARSE_MISS_QUOTATION_MARK, "[\"a\",[\"b]");
 }
 
 
@@ -396,6 +583,639 @@ static void test_parse_invalid_obj() {
     TEST_ERROR(LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET, "{\"a\":1]");
     TEST_ERROR(LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET, "{\"a\":1 \"b\"");
     TEST_ERROR(LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET, "{\"a\":{}");
+    TEST_ERROR(LEPT_PARSE_INVALID_VALUE, "{\"a\":[1,{\"b\":x}]}");
+}
+
+
+// 把json的前len个字节拷贝到恰好len字节的堆内存中再解析，越界读取会被内存检查工具发现
+#define TEST_PARSE_N(expect, types, json, len)\
+    do {\
+        lept_value v;\
+        char* buf = (char*)malloc(len);\
+        memcpy(buf, json, len);\
+        lept_init(&v);\
+        EXPECT_EQ_INT(expect, lept_parse_n(&v, buf, len));\
+        EXPECT_EQ_INT(types, lept_get_type(&v));\
+        lept_free(&v);\
+        free(buf);\
+    } while (0)
+
+
+/**
+ * @brief 测试按长度解析：不依赖末尾的'\0'，也不读取末尾之后的字节
+ * 
+ */
+static void test_parse_n() {
+    lept_value v;
+    TEST_PARSE_N(LEPT_PARSE_OK, LEPT_NULL, "null", 4);
+    TEST_PARSE_N(LEPT_PARSE_OK, LEPT_TRUE, "true", 4);
+    TEST_PARSE_N(LEPT_PARSE_OK, LEPT_NUMBER, "-1.5e3", 6);
+    TEST_PARSE_N(LEPT_PARSE_OK, LEPT_STRING, "\"\\u20AC\"", 8);
+    TEST_PARSE_N(LEPT_PARSE_OK, LEPT_ARRAY, " [1, \"a\"] ", 10);
+    TEST_PARSE_N(LEPT_PARSE_OK, LEPT_OBJECT, "{\"a\":{}}", 8);
+    TEST_PARSE_N(LEPT_PARSE_EXPECT_VALUE, LEPT_NULL, "  ", 2);
+    TEST_PARSE_N(LEPT_PARSE_EXPECT_VALUE, LEPT_NULL, "", 0);
+    TEST_PARSE_N(LEPT_PARSE_INVALID_VALUE, LEPT_NULL, "tru", 3);
+    TEST_PARSE_N(LEPT_PARSE_INVALID_VALUE, LEPT_NULL, "1.", 2);
+    TEST_PARSE_N(LEPT_PARSE_INVALID_VALUE, LEPT_NULL, "-", 1);
+    TEST_PARSE_N(LEPT_PARSE_MISS_QUOTATION_MARK, LEPT_NULL, "\"abc", 4);
+    TEST_PARSE_N(LEPT_PARSE_INVALID_STRING_ESCAPE, LEPT_NULL, "\"\\", 2);
+    TEST_PARSE_N(LEPT_PARSE_INVALID_UNICODE_HEX, LEPT_NULL, "\"\\u12", 5);
+    TEST_PARSE_N(LEPT_PARSE_INVALID_UNICODE_SURROGATE, LEPT_NULL, "\"\\uD834\\", 8);
+    TEST_PARSE_N(LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET, LEPT_NULL, "[1,2", 4);
+    TEST_PARSE_N(LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET, LEPT_NULL, "{\"a\":1", 6);
+    TEST_PARSE_N(LEPT_PARSE_MISS_COLON, LEPT_NULL, "{\"a\"", 4);
+    /* 长度之内的'\0'不再代表结束 */
+    TEST_PARSE_N(LEPT_PARSE_ROOT_NOT_SINGULAR, LEPT_NULL, "null\0", 5);
+    TEST_PARSE_N(LEPT_PARSE_INVALID_STRING_CHAR, LEPT_NULL, "[\"a\0b\"]", 7);
+
+    /* 只解析前len个字节 */
+    lept_init(&v);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_n(&v, "1234", 3));
+    EXPECT_EQ_DOUBLE(123.0, lept_get_number(&v));
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_n(&v, "[\"ab\"]xyz", 6));
+    EXPECT_EQ_STRING("ab", lept_get_string(lept_get_array_element(&v, 0)), lept_get_string_length(lept_get_array_element(&v, 0)));
+    lept_free(&v);
+}
+
+
+/* 把事件记录成一行文本，便于和预期比较 */
+typedef struct {
+    char log[256];
+    size_t len;
+    int limit;  /* 第 limit 个事件返回FALSE，0 表示不中止 */
+    int count;
+} sax_log;
+
+static int sax_append(void* user, const char* fmt, const char* s, size_t n) {
+    sax_log* l = (sax_log*)user;
+    l->len += snprintf(l->log + l->len, sizeof(l->log) - l->len, fmt, (int)n, s);
+    return ++l->count != l->limit;
+}
+static int sax_null(void* user) { return sax_append(user, "%.*sn ", "", 0); }
+static int sax_boolean(void* user, int b) { return sax_append(user, "%.*s ", b ? "t" : "f", 1); }
+static int sax_number(void* user, double n) {
+    char buf[32];
+    sprintf(buf, "%g", n);
+    return sax_append(user, "%.*s ", buf, strlen(buf));
+}
+static int sax_string(void* user, const char* s, size_t len) { return sax_append(user, "s:%.*s ", s, len); }
+static int sax_key(void* user, const char* s, size_t len) { return sax_append(user, "k:%.*s ", s, len); }
+static int sax_start_array(void* user) { return sax_append(user, "%.*s[ ", "", 0); }
+static int sax_end_array(void* user, size_t count) {
+    char buf[32];
+    sprintf(buf, "]%d", (int)count);
+    return sax_append(user, "%.*s ", buf, strlen(buf));
+}
+static int sax_start_object(void* user) { return sax_append(user, "%.*s{ ", "", 0); }
+static int sax_end_object(void* user, size_t count) {
+    char buf[32];
+    sprintf(buf, "}%d", (int)count);
+    return sax_append(user, "%.*s ", buf, strlen(buf));
+}
+
+static int sax_int64(void* user, int64_t i) {
+    char buf[32];
+    sprintf(buf, "i:%lld", (long long)i);
+    return sax_append(user, "%.*s ", buf, strlen(buf));
+}
+
+/* 整数回调留空：默认走 number 回调，需要时在测试里单独设置 */
+static const lept_handler sax_log_handler = {
+    sax_null, sax_boolean, sax_number, sax_string, sax_key,
+    sax_start_array, sax_end_array, sax_start_object, sax_end_object,
+    NULL, NULL
+};
+
+#define TEST_SAX(expect, events, json)\
+    do {\
+        sax_log l;\
+        l.len = 0; l.log[0] = '\0'; l.limit = 0; l.count = 0;\
+        EXPECT_EQ_INT(expect, lept_parse_sax(json, strlen(json), &sax_log_handler, &l));\
+        EXPECT_EQ_STRING(events, l.log, l.len);\
+    } while (0)
+
+
+/**
+ * @brief 测试事件解析接口
+ * 
+ */
+static void test_parse_sax() {
+    lept_handler h;
+    sax_log l;
+    TEST_SAX(LEPT_PARSE_OK, "n ", " null ");
+    TEST_SAX(LEPT_PARSE_OK, "t ", "true");
+    TEST_SAX(LEPT_PARSE_OK, "-1.5 ", "-1.5");
+    TEST_SAX(LEPT_PARSE_OK, "s:a\nb ", "\"a\\nb\"");
+    TEST_SAX(LEPT_PARSE_OK, "[ ]0 ", "[ ]");
+    TEST_SAX(LEPT_PARSE_OK, "{ }0 ", "{ }");
+    TEST_SAX(LEPT_PARSE_OK, "{ k:n n k:a [ f 1 s:x [ ]0 ]4 k:o { k:t t }1 }3 ",
+        "{\"n\":null,\"a\":[false,1,\"x\",[]],\"o\":{\"t\":true}}");
+    /* 出错前已发出的事件不撤回 */
+    TEST_SAX(LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET, "[ 1 ", "[1 2]");
+    TEST_SAX(LEPT_PARSE_MISS_KEY, "{ ", "{1:2}");
+    TEST_SAX(LEPT_PARSE_MISS_COLON, "{ k:a ", "{\"a\" 1}");
+    TEST_SAX(LEPT_PARSE_INVALID_STRING_ESCAPE, "[ ", "[\"\\v\"]");
+    TEST_SAX(LEPT_PARSE_ROOT_NOT_SINGULAR, "n ", "null x");
+    TEST_SAX(LEPT_PARSE_EXPECT_VALUE, "", "");
+
+    /* 回调返回FALSE时中止 */
+    l.len = 0; l.log[0] = '\0'; l.limit = 3; l.count = 0;
+    EXPECT_EQ_INT(LEPT_PARSE_TERMINATED, lept_parse_sax("[1,2,3,4]", 9, &sax_log_handler, &l));
+    EXPECT_EQ_STRING("[ 1 2 ", l.log, l.len);
+
+    /* 不关心的事件置为NULL */
+    memset(&h, 0, sizeof(h));
+    h.string = sax_string;
+    l.len = 0; l.log[0] = '\0'; l.limit = 0; l.count = 0;
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_sax("{\"a\":[\"b\",1,{\"c\":\"d\"}]}", 23, &h, &l));
+    EXPECT_EQ_STRING("s:b s:d ", l.log, l.len);
+
+    /* 整数回调 */
+    h = sax_log_handler;
+    h.int64 = sax_int64;
+    l.len = 0; l.log[0] = '\0'; l.limit = 0; l.count = 0;
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_sax("[-9007199254740993,1.5,18446744073709551615]", 44, &h, &l));
+    EXPECT_EQ_STRING("[ i:-9007199254740993 1.5 1.84467e+19 ]3 ", l.log, l.len);
+}
+
+
+/* 按 step 字节一块（step为0时在 split 处切成两块）送入增量解析器，结果应与 lept_parse_n 一致 */
+static void test_stream_split(const char* json, size_t step, size_t split) {
+    lept_stream ps;
+    lept_value v, expect;
+    size_t len = strlen(json), i, n;
+    int ret;
+    lept_init(&expect);
+    ret = lept_parse_n(&expect, json, len);
+    lept_stream_init(&ps, NULL, NULL);
+    for (i = 0; i < len; i += n) {
+        n = step ? step : (i < split ? split : len - split);
+        if (n > len - i)
+            n = len - i;
+        lept_stream_feed(&ps, json + i, n);
+    }
+    EXPECT_EQ_INT(ret, lept_stream_finish(&ps, &v));
+    EXPECT_TRUE(lept_is_equal(&expect, &v));
+    lept_stream_free(&ps);
+    lept_free(&v);
+    lept_free(&expect);
+}
+
+
+/**
+ * @brief 测试增量解析：任意切分输入，结果和错误码都与一次性解析相同
+ * 
+ */
+static void test_parse_stream() {
+    static const char* jsons[] = {
+        "null", " true ", "false", "0", "-0.0", "1.5E+10", "123456789", "1e-10000",
+        "\"\"", "\"Hello\\nWorld\"", "\"\\\" \\\\ \\/ \\b \\f \\n \\r \\t\"",
+        "\"\\u0024\\u00A2\\u20AC\\uD834\\uDD1E\"", "\"\\ud834\\udd1e\"",
+        "[ null , false , true , 123 , \"abc\" ]", "[ [ ] , [ 0 ] , [ 0 , 1 ] , [ 0 , 1 , 2 ] ]",
+        " { \"n\" : null , \"f\" : false , \"i\" : 123 , \"s\" : \"abc\", \"a\" : [ 1, 2, 3 ],"
+        " \"o\" : { \"1\" : 1, \"2\" : 2, \"3\" : 3 } } ",
+        /* 错误 */
+        "", " ", "nul", "?", "+0", ".123", "1.", "INF", "0123", "0x0", "1e309", "-1e309",
+        "[1,]", "[\"a\", nul]", "[0x0]", "\"abc", "\"\\v\"", "\"\\0\"", "\"\x01\"",
+        "\"\\u\"", "\"\\u01\"", "\"\\u012G\"", "\"\\uD800\"", "\"\\uDBFF\\\"", "\"\\uD800\\uE000\"",
+        "[1", "[1}", "[1 2", "[[]", "{:1,", "{1:1,", "{\"a\":1,\"b\"", "{\"a\"}", "{\"a\",\"b\"}",
+        "{\"a\":1", "{\"a\":1]", "{\"a\":1 \"b\"", "{\"a\":{}", "{\"\\v\":1}", "{\"a\":1,}",
+        "null x", "1 2", "[] {}", "\"a\"b"
+    };
+    lept_stream ps;
+    sax_log l;
+    size_t i, j;
+    for (i = 0; i < sizeof(jsons) / sizeof(jsons[0]); i++) {
+        test_stream_split(jsons[i], 1, 0);
+        for (j = 0; j <= strlen(jsons[i]); j++)
+            test_stream_split(jsons[i], 0, j);
+    }
+
+    /* 事件模式 */
+    l.len = 0; l.log[0] = '\0'; l.limit = 0; l.count = 0;
+    lept_stream_init(&ps, &sax_log_handler, &l);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_stream_feed(&ps, "{\"n\":null,\"a\":[fa", 17));
+    EXPECT_EQ_STRING("{ k:n n k:a [ ", l.log, l.len);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_stream_feed(&ps, "lse,1", 5));
+    EXPECT_EQ_STRING("{ k:n n k:a [ f ", l.log, l.len);  /* 数字可能未完，尚未发出 */
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_stream_feed(&ps, "]}", 2));
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_stream_finish(&ps, NULL));
+    EXPECT_EQ_STRING("{ k:n n k:a [ f 1 ]2 }2 ", l.log, l.len);
+    lept_stream_free(&ps);
+
+    /* 出错后保持错误 */
+    l.len = 0; l.log[0] = '\0'; l.limit = 3; l.count = 0;
+    lept_stream_init(&ps, &sax_log_handler, &l);
+    EXPECT_EQ_INT(LEPT_PARSE_TERMINATED, lept_stream_feed(&ps, "[1,2,3]", 7));
+    EXPECT_EQ_INT(LEPT_PARSE_TERMINATED, lept_stream_feed(&ps, "", 0));
+    EXPECT_EQ_INT(LEPT_PARSE_TERMINATED, lept_stream_finish(&ps, NULL));
+    EXPECT_EQ_STRING("[ 1 2 ", l.log, l.len);
+    lept_stream_free(&ps);
+}
+
+
+/**
+ * @brief 测试就地解析：字符串在输入缓冲区内反转义，不再拷贝
+ * 
+ */
+static void test_parse_insitu() {
+    char json[] = "{\"k\\u0041\":\"Hello\\nWorld\",\"a\":[\"\\uD834\\uDD1E\",\"x\"]}";
+    char bad[] = "[\"a\",\"\\v\"]";
+    lept_value v, *s;
+    lept_init(&v);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_insitu(&v, json));
+    EXPECT_EQ_STRING("kA", lept_get_object_key(&v, 0), lept_get_object_key_length(&v, 0));
+    EXPECT_TRUE(lept_get_object_key(&v, 0) > json && lept_get_object_key(&v, 0) < json + sizeof(json));
+    s = lept_get_object_value(&v, 0);
+    EXPECT_EQ_STRING("Hello\nWorld", lept_get_string(s), lept_get_string_length(s));
+    EXPECT_TRUE(lept_get_string(s) > json && lept_get_string(s) < json + sizeof(json));
+    EXPECT_EQ_INT('\0', lept_get_string(s)[lept_get_string_length(s)]);
+    s = lept_get_array_element(lept_find_object_value(&v, "a", 1), 0);
+    EXPECT_EQ_STRING("\xF0\x9D\x84\x9E", lept_get_string(s), lept_get_string_length(s));
+
+    /* 修改借用的键/字符串 */
+    lept_set_string(s, "abc", 3);
+    lept_set_null(lept_set_object_value(&v, "n", 1));
+    EXPECT_EQ_SIZE_T(3, lept_get_object_size(&v));
+    EXPECT_EQ_STRING("kA", lept_get_object_key(&v, 0), lept_get_object_key_length(&v, 0));
+    lept_free(&v);
+
+    EXPECT_EQ_INT(LEPT_PARSE_INVALID_STRING_ESCAPE, lept_parse_insitu(&v, bad));
+    EXPECT_EQ_INT(LEPT_NULL, lept_get_type(&v));
+}
+
+
+/**
+ * @brief 测试arena解析：访问接口可用，修改借用的数组/对象时拷贝到堆上，最后一次性释放
+ * 
+ */
+static void test_parse_arena() {
+    lept_arena a;
+    lept_value v, e;
+    char* json;
+    size_t length, i;
+    lept_arena_init(&a, 64); /* 小块，强制分配多块 */
+
+    for (i = 0; i < 2; i++) {  /* 第二轮复用reset后保留的块 */
+        lept_init(&v);
+        EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_arena(&v,
+            "{\"n\":null,\"s\":\"Hello\\nWorld\",\"a\":[1,\"abc\",[2,3]],\"o\":{\"k\":true}}", &a));
+        EXPECT_EQ_INT(LEPT_OBJECT, lept_get_type(&v));
+        EXPECT_EQ_SIZE_T(4, lept_get_object_size(&v));
+        EXPECT_EQ_STRING("Hello\nWorld", lept_get_string(lept_find_object_value(&v, "s", 1)),
+            lept_get_string_length(lept_find_object_value(&v, "s", 1)));
+        EXPECT_EQ_SIZE_T(3, lept_get_array_size(lept_find_object_value(&v, "a", 1)));
+        EXPECT_EQ_STRING("abc", lept_get_string(lept_get_array_element(lept_find_object_value(&v, "a", 1), 1)), 3);
+        EXPECT_TRUE(lept_get_boolean(lept_find_object_value(lept_find_object_value(&v, "o", 1), "k", 1)));
+
+        /* 修改arena中的树 */
+        lept_init(&e);
+        lept_set_number(&e, 4.0);
+        lept_move(lept_pushback_array_element(lept_find_object_value(&v, "a", 1)), &e);
+        lept_set_string(lept_find_object_value(&v, "s", 1), "Hi", 2);
+        lept_set_boolean(lept_set_object_value(&v, "t", 1), TRUE);
+        lept_remove_object_value_index(&v, 0);
+        EXPECT_EQ_INT(LEPT_STRINGIFY_OK, lept_stringify(&v, &json, &length));
+        EXPECT_EQ_STRING("{\"s\":\"Hi\",\"a\":[1,\"abc\",[2,3],4],\"o\":{\"k\":true},\"t\":true}", json, length);
+        free(json);
+
+        lept_free(&v);  /* 只释放修改时拷贝到堆上的部分 */
+        lept_arena_reset(&a);
+    }
+
+    /* 错误时不泄漏、不释放arena内存 */
+    EXPECT_EQ_INT(LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET, lept_parse_arena(&v, "{\"a\":[\"b\"],\"c\":\"d\"", &a));
+    EXPECT_EQ_INT(LEPT_NULL, lept_get_type(&v));
+    EXPECT_EQ_INT(LEPT_PARSE_ROOT_NOT_SINGULAR, lept_parse_arena(&v, "[\"x\"] y", &a));
+    EXPECT_EQ_INT(LEPT_NULL, lept_get_type(&v));
+    lept_arena_free(&a);
+}
+
+
+/**
+ * @brief 测试键池：相同的键（包括转义后相同的键）跨文档共享同一个缓冲区，修改时新键由对象自己持有
+ * 
+ */
+static void test_parse_keypool() {
+    lept_keypool p;
+    lept_value v1, v2;
+    char key[16];
+    const char* k;
+    char* json;
+    size_t length, i;
+    lept_keypool_init(&p);
+
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_keypool(&v1, "[{\"id\":1,\"name\":\"a\"},{\"name\":\"b\",\"id\":2}]", &p));
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_keypool(&v2, "{\"\\u0069d\":3,\"tag\":{\"name\":\"c\"}}", &p));
+    k = lept_get_object_key(lept_get_array_element(&v1, 0), 0);
+    EXPECT_EQ_STRING("id", k, 2);
+    EXPECT_TRUE(k == lept_get_object_key(lept_get_array_element(&v1, 1), 1));
+    EXPECT_TRUE(k == lept_get_object_key(&v2, 0));  /* 转义后相同 */
+    EXPECT_TRUE(k == lept_keypool_intern(&p, "id", 2));
+    EXPECT_TRUE(lept_get_object_key(lept_get_array_element(&v1, 0), 1) == lept_get_object_key(lept_find_object_value(&v2, "tag", 3), 0));
+    EXPECT_EQ_SIZE_T(3, p.count);
+    EXPECT_EQ_DOUBLE(2.0, lept_get_number(lept_find_object_value(lept_get_array_element(&v1, 1), k, 2)));
+
+    /* 修改：新键由对象持有，池中的键不受影响 */
+    lept_set_boolean(lept_set_object_value(&v2, "x", 1), TRUE);
+    lept_remove_object_value_index(&v2, 0);
+    EXPECT_EQ_INT(LEPT_STRINGIFY_OK, lept_stringify(&v2, &json, &length));
+    EXPECT_EQ_STRING("{\"tag\":{\"name\":\"c\"},\"x\":true}", json, length);
+    free(json);
+    lept_free(&v2);
+    EXPECT_EQ_STRING("id", k, 2);
+
+    /* 池扩容后已驻留的键不移动 */
+    for (i = 0; i < 200; i++) {
+        sprintf(key, "k%d", (int)i);
+        lept_keypool_intern(&p, key, strlen(key));
+    }
+    EXPECT_EQ_SIZE_T(203, p.count);
+    EXPECT_TRUE(k == lept_keypool_intern(&p, "id", 2));
+    EXPECT_EQ_STRING("k123", lept_keypool_intern(&p, "k123", 4), 4);
+    EXPECT_EQ_SIZE_T(203, p.count);
+
+    /* 错误时不释放池中的键 */
+    EXPECT_EQ_INT(LEPT_PARSE_MISS_COLON, lept_parse_keypool(&v2, "{\"id\":1,\"name\"}", &p));
+    EXPECT_EQ_INT(LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET, lept_parse_keypool(&v2, "{\"id\":{\"id\":[1}}", &p));
+    EXPECT_EQ_INT(LEPT_NULL, lept_get_type(&v2));
+    EXPECT_EQ_SIZE_T(203, p.count);
+
+    lept_free(&v1);
+    lept_keypool_free(&p);
+}
+
+/**
+ * @brief 测试懒惰解析：容器在访问时逐层展开，结果与完整解析相同
+ * 
+ */
+static void test_parse_lazy() {
+    static const char* json = " {\"a\" : [1, 2, {\"b\":\"x]}\\\"\"}], \"s\":\"str\", \"o\":{\"k\":[true, \"[\"]}} ";
+    lept_value v, full, w;
+    lept_value* a;
+    char* out;
+    size_t len;
+    lept_init(&full);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&full, json));
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_lazy(&v, json));
+    EXPECT_EQ_INT(LEPT_OBJECT, lept_get_type(&v));
+    EXPECT_TRUE(v.flags & LEPT_FLAG_LAZY);
+    EXPECT_EQ_SIZE_T(3, lept_get_object_size(&v));
+    EXPECT_FALSE(v.flags & LEPT_FLAG_LAZY);
+    a = lept_find_object_value(&v, "a", 1);
+    EXPECT_TRUE(a->flags & LEPT_FLAG_LAZY);
+    EXPECT_TRUE(lept_find_object_value(&v, "o", 1)->flags & LEPT_FLAG_LAZY);
+    EXPECT_EQ_STRING("x]}\"", lept_get_string(lept_find_object_value(lept_get_array_element(a, 2), "b", 1)), 4);
+    EXPECT_TRUE(lept_find_object_value(&v, "o", 1)->flags & LEPT_FLAG_LAZY);
+
+    /* 复制、修改、比较、生成 */
+    lept_init(&w);
+    lept_copy(&w, lept_find_object_value(&v, "o", 1));
+    EXPECT_TRUE(w.flags & LEPT_FLAG_LAZY);
+    lept_set_null(lept_pushback_array_element(lept_find_object_value(&w, "k", 1)));
+    EXPECT_EQ_SIZE_T(3, lept_get_array_size(lept_find_object_value(&w, "k", 1)));
+    lept_free(&w);
+    EXPECT_TRUE(lept_is_equal(&full, &v));
+    EXPECT_EQ_INT(LEPT_STRINGIFY_OK, lept_stringify(&v, &out, &len));
+    EXPECT_EQ_STRING("{\"a\":[1,2,{\"b\":\"x]}\\\"\"}],\"s\":\"str\",\"o\":{\"k\":[true,\"[\"]}}", out, len);
+    free(out);
+    lept_free(&v);
+    lept_free(&full);
+
+    /* 容器内部的错误在解析时就报告，不会在展开时被访问接口吞掉 */
+    EXPECT_EQ_INT(LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET, lept_parse_lazy(&v, "[1,[2]"));
+    EXPECT_EQ_INT(LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET, lept_parse_lazy(&v, "{\"a\":{}"));
+    EXPECT_EQ_INT(LEPT_PARSE_MISS_QUOTATION_MARK, lept_parse_lazy(&v, "[\"]\\\"]"));
+    EXPECT_EQ_INT(LEPT_PARSE_ROOT_NOT_SINGULAR, lept_parse_lazy(&v, "[] x"));
+    EXPECT_EQ_INT(LEPT_PARSE_INVALID_VALUE, lept_parse_lazy(&v, "[\"abc\", [1,], 3]"));
+    EXPECT_EQ_INT(LEPT_PARSE_INVALID_VALUE, lept_parse_lazy(&v, "[[1,x],{\"a\":}]"));
+    EXPECT_EQ_INT(LEPT_PARSE_INVALID_VALUE, lept_parse_lazy(&v, "{\"a\":[1],\"b\":{\"c\":tru}}"));
+    EXPECT_EQ_INT(LEPT_PARSE_MISS_COLON, lept_parse_lazy(&v, "[{\"a\" 1}]"));
+    EXPECT_EQ_INT(LEPT_PARSE_INVALID_STRING_ESCAPE, lept_parse_lazy(&v, "[[\"\\x\"]]"));
+    EXPECT_EQ_INT(LEPT_NULL, lept_get_type(&v));
+
+    /* 根是标量时直接解析；根容器的范围不含首尾空白 */
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_lazy(&v, " \"s\" "));
+    EXPECT_EQ_STRING("s", lept_get_string(&v), lept_get_string_length(&v));
+    lept_free(&v);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_lazy(&v, "\t[ 1 ]\r\n"));
+    EXPECT_TRUE(v.flags & LEPT_FLAG_LAZY);
+    EXPECT_EQ_SIZE_T(5, v.u.s.size);
+    EXPECT_EQ_DOUBLE(1.0, lept_get_number(lept_get_array_element(&v, 0)));
+    lept_free(&v);
+}
+
+#define TEST_SKIP(expect, json, skipped)\
+    do {\
+        size_t end = 0;\
+        EXPECT_EQ_INT(expect, lept_skip_value(json, strlen(json), &end));\
+        if (expect == LEPT_PARSE_OK)\
+            EXPECT_EQ_SIZE_T(skipped, end);\
+    } while(0)
+
+/* 随机生成合法的JSON，字符串里混入引号、反斜杠和括号 */
+static void random_json(char* buf, size_t* len, int depth) {
+    static const char* pieces[] = { "a", "\\\"", "\\\\", "[", "]", "{", "}", "\\u005D", " " };
+    size_t i, n;
+    switch (random_next() % (depth < 4 ? 4 : 2)) {
+        case 0:
+            buf[(*len)++] = '"';
+            for (n = random_next() % 12; n > 0; n--) {
+                const char* q = pieces[random_next() % 9];
+                memcpy(buf + *len, q, strlen(q));
+                *len += strlen(q);
+            }
+            buf[(*len)++] = '"';
+            break;
+        case 1:
+            *len += sprintf(buf + *len, "%d", (int)(random_next() % 1000));
+            break;
+        case 2:
+            buf[(*len)++] = '[';
+            for (i = 0, n = random_next() % 5; i < n; i++) {
+                if (i) buf[(*len)++] = ',';
+                random_json(buf, len, depth + 1);
+            }
+            buf[(*len)++] = ']';
+            break;
+        default:
+            buf[(*len)++] = '{';
+            for (i = 0, n = random_next() % 5; i < n; i++) {
+                if (i) buf[(*len)++] = ',';
+                *len += sprintf(buf + *len, "\"k\\\\%d\":", (int)i);
+                random_json(buf, len, depth + 1);
+            }
+            buf[(*len)++] = '}';
+    }
+}
+
+/**
+ * @brief 测试跳过值：只配对括号和字符串，结束位置与完整解析一致
+ * 
+ */
+static void test_skip_value() {
+    static char buf[1 << 16];
+    lept_value v;
+    size_t len, end;
+    int i;
+    TEST_SKIP(LEPT_PARSE_OK, " null , 1", 5);
+    TEST_SKIP(LEPT_PARSE_OK, "-1.5e3]", 6);
+    TEST_SKIP(LEPT_PARSE_OK, "\"a\\\"b\\\\\":1", 8);
+    TEST_SKIP(LEPT_PARSE_OK, "[1,[2,\"]\"],{\"}\":[]}] ,", 20);
+    TEST_SKIP(LEPT_PARSE_OK, "{} {}", 2);
+    TEST_SKIP(LEPT_PARSE_EXPECT_VALUE, "  ", 0);
+    TEST_SKIP(LEPT_PARSE_INVALID_VALUE, "]", 0);
+    TEST_SKIP(LEPT_PARSE_MISS_QUOTATION_MARK, "\"abc\\\"", 0);
+    TEST_SKIP(LEPT_PARSE_MISS_QUOTATION_MARK, "[\"]", 0);
+    TEST_SKIP(LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET, "[[1]", 0);
+    TEST_SKIP(LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET, "{\"a\":{}", 0);
+
+    /* 随机文档跨越多个64字节的块 */
+    for (i = 0; i < 2000; i++) {
+        len = 0;
+        random_json(buf, &len, i % 2 ? 0 : 2);
+        buf[len] = '\0';
+        lept_init(&v);
+        EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, buf));
+        lept_free(&v);
+        memcpy(buf + len, " ,]}\"", 6);
+        end = 0;
+        EXPECT_EQ_INT(LEPT_PARSE_OK, lept_skip_value(buf, len + 5, &end));
+        EXPECT_EQ_SIZE_T(len, end);
+        if (buf[0] == '[' || buf[0] == '{')  /* 缺少最后一个右括号 */
+            EXPECT_TRUE(lept_skip_value(buf, len - 1, &end) != LEPT_PARSE_OK);
+    }
+}
+
+#define TEST_VALIDATE(expect, json, offset)\
+    do {\
+        size_t off = (size_t)-1;\
+        EXPECT_EQ_INT(expect, lept_validate(json, strlen(json), &off));\
+        EXPECT_EQ_SIZE_T(offset, off);\
+    } while(0)
+
+/**
+ * @brief 测试只校验：结果与解析相同，出错位置指向出错的字节
+ * 
+ */
+static void test_validate() {
+    static const char mutations[] = " ,:[]{}\"\\0-e.tx\x01";  /* 连同结尾的'\0' */
+    static char buf[1 << 16];
+    lept_value v;
+    size_t len, off;
+    int i, j;
+    TEST_VALIDATE(LEPT_PARSE_EXPECT_VALUE, " ", 1);
+    TEST_VALIDATE(LEPT_PARSE_INVALID_VALUE, "[1, nul]", 4);
+    TEST_VALIDATE(LEPT_PARSE_INVALID_VALUE, "[1,]", 3);
+    TEST_VALIDATE(LEPT_PARSE_ROOT_NOT_SINGULAR, "{} x", 3);
+    TEST_VALIDATE(LEPT_PARSE_NUMBER_TOO_BIG, "[0, -1e309]", 4);
+    TEST_VALIDATE(LEPT_PARSE_MISS_QUOTATION_MARK, "[\"abc", 5);
+    TEST_VALIDATE(LEPT_PARSE_INVALID_STRING_ESCAPE, "\"ab\\x\"", 3);
+    TEST_VALIDATE(LEPT_PARSE_INVALID_STRING_CHAR, "\"a\x01\"", 2);
+    TEST_VALIDATE(LEPT_PARSE_INVALID_UNICODE_SURROGATE, "\"\\uD800\\u0041\"", 1);
+    TEST_VALIDATE(LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET, "[[1] 2]", 5);
+    TEST_VALIDATE(LEPT_PARSE_MISS_KEY, "{\"a\":1, 2}", 8);
+    TEST_VALIDATE(LEPT_PARSE_MISS_KEY, "{\"a\\x\":1}", 1);
+    TEST_VALIDATE(LEPT_PARSE_MISS_COLON, "{\"a\" 1}", 5);
+    TEST_VALIDATE(LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET, "{\"a\":[]]", 7);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_validate("[1]", 3, NULL));
+    EXPECT_EQ_INT(LEPT_PARSE_EXPECT_VALUE, lept_validate(NULL, 0, NULL));
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_validate("1.5e3]", 5, NULL));  /* 不读取 len 之后的字节 */
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_validate("\"a\\u00e9\"x", 9, NULL));
+
+    /* 超过一个栈帧记录的层数 */
+    len = 0;
+    for (i = 0; i < 3000; i++) {
+        if (i % 3)
+            buf[len++] = '[';
+        else
+            len += sprintf(buf + len, "{\"k\":");
+    }
+    buf[len++] = '1';
+    for (i = 2999; i >= 0; i--)
+        buf[len++] = i % 3 ? ']' : '}';
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_validate(buf, len, NULL));
+    EXPECT_EQ_INT(LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET, lept_validate(buf, len - 1, &off));
+    EXPECT_EQ_SIZE_T(len - 1, off);
+    buf[len - 2] = '}';  /* 最外层的对象里多出一个右括号 */
+    EXPECT_EQ_INT(LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET, lept_validate(buf, len, NULL));
+
+    /* 随机文档及其变形：结果与 lept_parse_n 相同 */
+    for (i = 0; i < 2000; i++) {
+        len = 0;
+        random_json(buf, &len, 2);
+        EXPECT_EQ_INT(LEPT_PARSE_OK, lept_validate(buf, len, NULL));
+        for (j = 0; j < 4; j++) {
+            size_t n = random_next() % (len + 1);
+            buf[random_next() % len] = mutations[random_next() % sizeof(mutations)];
+            lept_init(&v);
+            EXPECT_EQ_INT(lept_parse_n(&v, buf, n), lept_validate(buf, n, NULL));
+            lept_free(&v);
+        }
+    }
+}
+
+#define TEST_PROJECTED(expect, json, ...)\
+    do {\
+        static const char* paths[] = { __VA_ARGS__ };\
+        lept_value v;\
+        char* out;\
+        size_t len;\
+        EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_projected(&v, json, paths, sizeof(paths) / sizeof(paths[0])));\
+        EXPECT_EQ_INT(LEPT_STRINGIFY_OK, lept_stringify(&v, &out, &len));\
+        EXPECT_EQ_STRING(expect, out, len);\
+        free(out);\
+        lept_free(&v);\
+    } while(0)
+
+/**
+ * @brief 测试投影解析：只保留路径上的值，"*" 匹配任意键或下标
+ * 
+ */
+static void test_parse_projected() {
+    static const char* json = "{\"user\":{\"id\":7,\"name\":\"n\",\"tags\":[\"a\",\"b\"]},"
+                              "\"items\":[{\"price\":1.5,\"qty\":2},{\"qty\":3},{\"price\":2,\"sku\":{\"x\":[1]}}],"
+                              "\"a/b\":{\"~\":true},\"skip\":[\"]}\\\"\",{\"k\":[]}]}";
+    lept_value v;
+    TEST_PROJECTED("{\"user\":{\"id\":7}}", json, "/user/id");
+    TEST_PROJECTED("{\"user\":{\"id\":7},\"items\":[{\"price\":1.5},{},{\"price\":2}]}", json, "/user/id", "/items/*/price");
+    TEST_PROJECTED("{\"user\":{\"id\":7,\"name\":\"n\",\"tags\":[\"a\",\"b\"]}}", json, "/user/id", "/user");
+    TEST_PROJECTED("{\"items\":[{\"qty\":3}]}", json, "/items/1/qty");
+    TEST_PROJECTED("{\"items\":[{\"price\":1.5,\"qty\":2},{\"qty\":3},{}]}", json, "/items/0", "/items/*/qty");
+    TEST_PROJECTED("{\"user\":{\"id\":7,\"tags\":[]},\"items\":[{\"price\":1.5},{},{\"price\":2}],\"a/b\":{},\"skip\":[{}]}",
+                   json, "/*/id", "/*/*/price");
+    TEST_PROJECTED("{\"a/b\":{\"~\":true}}", json, "/a~1b/~0");
+    TEST_PROJECTED("{\"user\":{}}", json, "/user/id/x", "/user/none");
+    TEST_PROJECTED("{}", json, "/missing");
+    TEST_PROJECTED("{\"skip\":[{\"k\":[]}]}", json, "/skip/1");
+    TEST_PROJECTED("[[2],[4]]", "[[1,2],[3,4],5]", "/*/1");
+    TEST_PROJECTED("3", " 3 ", "/a");
+    TEST_PROJECTED("{\"user\":{\"id\":7,\"name\":\"n\",\"tags\":[\"a\",\"b\"]},\"items\":[{\"price\":1.5,\"qty\":2},{\"qty\":3},"
+                   "{\"price\":2,\"sku\":{\"x\":[1]}}],\"a/b\":{\"~\":true},\"skip\":[\"]}\\\"\",{\"k\":[]}]}", json, "");
+
+    /* 跳过的值不检查内容，但括号和字符串必须闭合 */
+    {
+        static const char* paths[] = { "/a" };
+        EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_projected(&v, "{\"a\":1,\"b\":[tru]}", paths, 1));
+        lept_free(&v);
+        EXPECT_EQ_INT(LEPT_PARSE_INVALID_VALUE, lept_parse_projected(&v, "{\"a\":tru,\"b\":1}", paths, 1));
+        EXPECT_EQ_INT(LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET, lept_parse_projected(&v, "{\"a\":1,\"b\":[}", paths, 1));
+        EXPECT_EQ_INT(LEPT_PARSE_MISS_KEY, lept_parse_projected(&v, "{\"a\":1,\"b\":2,}", paths, 1));
+        EXPECT_EQ_INT(LEPT_PARSE_ROOT_NOT_SINGULAR, lept_parse_projected(&v, "{} x", paths, 1));
+    }
+
+    /* 不合法的路径 */
+    {
+        static const char* paths[] = { "/a", "a" };
+        static const char* tilde[] = { "/a~2" };
+        lept_init(&v);
+        lept_set_boolean(&v, 1);
+        EXPECT_EQ_INT(LEPT_PARSE_INVALID_PATH, lept_parse_projected(&v, "{\"a\":1}", paths, 2));
+        EXPECT_EQ_INT(LEPT_NULL, lept_get_type(&v));
+        EXPECT_EQ_INT(LEPT_PARSE_INVALID_PATH, lept_parse_projected(&v, "{\"a\":1}", paths + 1, 1));
+        EXPECT_EQ_INT(LEPT_PARSE_INVALID_PATH, lept_parse_projected(&v, "{\"a\":1}", tilde, 1));
+    }
 }
 
 
@@ -439,6 +1259,16 @@ static void test_access_number() {
     lept_set_null(&v);
     lept_set_number(&v, -2.5);
     EXPECT_EQ_DOUBLE(-2.5, lept_get_number(&v));
+    EXPECT_FALSE(lept_is_int64(&v));
+    lept_set_int64(&v, INT64_MIN);
+    EXPECT_TRUE(lept_is_int64(&v));
+    EXPECT_TRUE(lept_get_int64(&v) == INT64_MIN);
+    EXPECT_EQ_DOUBLE(-9223372036854775808.0, lept_get_number(&v));
+    lept_set_uint64(&v, UINT64_MAX);
+    EXPECT_TRUE(lept_is_uint64(&v));
+    EXPECT_TRUE(lept_get_uint64(&v) == UINT64_MAX);
+    lept_set_number(&v, 42.0);
+    EXPECT_TRUE(lept_get_int64(&v) == 42);
     lept_free(&v);
 }
 
@@ -458,6 +1288,66 @@ static void test_access_string() {
 }
 
 
+/**
+ * @brief 测试紧凑布局：值只占16字节，容量记录在堆上数组的头部
+ * 
+ */
+static void test_access_compact() {
+#ifdef LEPT_COMPACT_VALUE
+    lept_value v;
+    EXPECT_EQ_SIZE_T(16, sizeof(lept_value));
+    lept_init(&v);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, "[1,2,3]"));
+    EXPECT_EQ_SIZE_T(3, lept_get_array_size(&v));
+    EXPECT_EQ_SIZE_T(6, lept_get_array_capacity(&v));
+    lept_shrink_array(&v);
+    EXPECT_EQ_SIZE_T(3, lept_get_array_capacity(&v));
+    lept_erase_array_element(&v, 0, 3);
+    lept_shrink_array(&v);
+    EXPECT_EQ_SIZE_T(0, lept_get_array_capacity(&v));
+    lept_set_number(lept_pushback_array_element(&v), 4.0);
+    EXPECT_EQ_SIZE_T(1, lept_get_array_capacity(&v));
+    lept_free(&v);
+#endif
+}
+
+/**
+ * @brief 测试短字符串：存放在值内，长度在边界两侧时读写、拷贝、移动、交换和解析结果一致
+ * 
+ */
+static void test_access_short_string() {
+    const char* s = "0123456789abcdef0123456789abcdef";
+    lept_value v, w;
+    char json[64];
+    size_t len;
+    for (len = LEPT_SHORT_STRING_MAX - 1; len <= LEPT_SHORT_STRING_MAX + 1; len++) {
+        lept_init(&v);
+        lept_init(&w);
+        lept_set_string(&v, s, len);
+        EXPECT_TRUE(lept_get_string_length(&v) == len && memcmp(s, lept_get_string(&v), len) == 0);
+        EXPECT_EQ_INT(len <= LEPT_SHORT_STRING_MAX, (v.flags & LEPT_FLAG_SHORT) != 0);
+        EXPECT_EQ_INT('\0', lept_get_string(&v)[len]);
+        lept_copy(&w, &v);
+        EXPECT_TRUE(lept_get_string_length(&w) == len && memcmp(s, lept_get_string(&w), len) == 0);
+        EXPECT_TRUE(lept_is_equal(&v, &w));
+        lept_set_number(&v, 1.0);
+        lept_swap(&v, &w);
+        EXPECT_TRUE(lept_get_string_length(&v) == len && memcmp(s, lept_get_string(&v), len) == 0);
+        lept_move(&w, &v);
+        EXPECT_TRUE(lept_get_string_length(&w) == len && memcmp(s, lept_get_string(&w), len) == 0);
+        EXPECT_EQ_INT(LEPT_NULL, lept_get_type(&v));
+        lept_free(&w);
+
+        sprintf(json, "[\"%.*s\",\"\\u0041%.*s\"]", (int)len, s, (int)len - 1, s);
+        EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, json));
+        EXPECT_TRUE(lept_get_string_length(lept_get_array_element(&v, 0)) == len && memcmp(s, lept_get_string(lept_get_array_element(&v, 0)), len) == 0);
+        EXPECT_EQ_SIZE_T(len, lept_get_string_length(lept_get_array_element(&v, 1)));
+        EXPECT_EQ_INT('A', lept_get_string(lept_get_array_element(&v, 1))[0]);
+        lept_free(&v);
+    }
+}
+
+
 /**
  * @brief 测试数组类型的access接口
  * 
@@ -539,6 +1429,139 @@ static void test_access_arrary() {
     lept_free(&e);
 }
 
+/**
+ * @brief 测试紧凑的数字数组：解析时自动紧凑存储，批量读写，按元素读取不改变存储，按元素写入时转换回一般数组
+ * 
+ */
+static void test_access_number_array() {
+    static const char* json = "[0,1,-2,3.5,4e2,5,6,7,8,9,10,11,12,13,14,-0.25]";
+    static const double expect[] = { 0, 1, -2, 3.5, 400, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, -0.25 };
+    double more[40];
+    const double* n;
+    lept_value v, w, *pa, *pb;
+    lept_stream ps;
+    lept_arena a;
+    char* out;
+    size_t len, i;
+    lept_init(&v);
+    lept_init(&w);
+
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, json));
+    EXPECT_TRUE(v.flags & LEPT_FLAG_PACKED);
+    EXPECT_TRUE(lept_get_number_array(&v, &n, &len));
+    EXPECT_EQ_SIZE_T(16, len);
+    EXPECT_TRUE(memcmp(expect, n, sizeof(expect)) == 0);
+    EXPECT_EQ_INT(LEPT_STRINGIFY_OK, lept_stringify(&v, &out, &len));
+    EXPECT_EQ_STRING("[0,1,-2,3.5,400,5,6,7,8,9,10,11,12,13,14,-0.25]", out, len);
+    free(out);
+    lept_copy(&w, &v);
+    EXPECT_TRUE(w.flags & LEPT_FLAG_PACKED);
+    EXPECT_TRUE(lept_is_equal(&v, &w));
+
+    /* 增量解析同样紧凑存储 */
+    lept_free(&w);
+    lept_stream_init(&ps, NULL, NULL);
+    lept_stream_feed(&ps, json, strlen(json));
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_stream_finish(&ps, &w));
+    lept_stream_free(&ps);
+    EXPECT_TRUE(w.flags & LEPT_FLAG_PACKED);
+    EXPECT_TRUE(lept_is_equal(&v, &w));
+
+    /* 删除和按值读取不改变存储形式；取元素指针后转换回一般数组，整数元素还原为整数，与紧凑数组仍然相等 */
+    lept_popback_array_element(&w);
+    lept_erase_array_element(&w, 0, 2);
+    EXPECT_TRUE(w.flags & LEPT_FLAG_PACKED);
+    EXPECT_TRUE(lept_get_number_array(&w, &n, &len));
+    EXPECT_EQ_SIZE_T(13, len);
+    EXPECT_EQ_DOUBLE(-2.0, n[0]);
+    EXPECT_EQ_DOUBLE(-0.25, lept_get_array_number(&v, 15));
+    EXPECT_EQ_DOUBLE(-2.0, lept_get_array_number(&v, 2));
+    EXPECT_TRUE(v.flags & LEPT_FLAG_PACKED);
+    EXPECT_EQ_DOUBLE(3.5, lept_get_number(lept_get_array_element(&v, 3)));
+    EXPECT_FALSE(v.flags & LEPT_FLAG_PACKED);
+    EXPECT_FALSE(lept_is_int64(lept_get_array_element(&v, 3)));
+    EXPECT_TRUE(lept_is_int64(lept_get_array_element(&v, 2)));
+    EXPECT_TRUE(lept_get_int64(lept_get_array_element(&v, 2)) == -2);
+    EXPECT_TRUE(lept_is_int64(lept_get_array_element(&v, 0)));
+    EXPECT_FALSE(lept_is_int64(lept_get_array_element(&v, 15)));
+    EXPECT_EQ_SIZE_T(16, lept_get_array_size(&v));
+    lept_set_number_array(&w, expect, 16);
+    EXPECT_TRUE(lept_is_equal(&v, &w));
+
+    /* 写入非数字后批量读取失败；纯数字时重新转换 */
+    lept_set_string(lept_get_array_element(&v, 0), "a", 1);
+    EXPECT_FALSE(lept_get_number_array(&v, &n, &len));
+    EXPECT_EQ_INT(LEPT_STRING, lept_get_type(lept_get_array_element(&v, 0)));
+    lept_set_number(lept_get_array_element(&v, 0), 0.0);
+    EXPECT_TRUE(lept_get_number_array(&v, &n, &len));
+    EXPECT_TRUE(v.flags & LEPT_FLAG_PACKED);
+    EXPECT_TRUE(lept_is_equal(&v, &w));
+
+    /* 紧凑数组的元素指针各自指向真实的元素，通过它们的写入都保留 */
+    EXPECT_TRUE(w.flags & LEPT_FLAG_PACKED);
+    pa = lept_get_array_element(&w, 0);
+    pb = lept_get_array_element(&w, 1);
+    EXPECT_TRUE(pa != pb);
+    lept_set_number(pa, 100.0);
+    lept_set_string(pb, "a string longer than the inline buffer", 38);
+    EXPECT_EQ_DOUBLE(100.0, lept_get_number(lept_get_array_element(&w, 0)));
+    EXPECT_EQ_STRING("a string longer than the inline buffer", lept_get_string(lept_get_array_element(&w, 1)), 38);
+    EXPECT_EQ_DOUBLE(-2.0, lept_get_array_number(&w, 2));
+    EXPECT_FALSE(lept_get_number_array(&w, &n, &len));
+    lept_set_number(pb, 1.0);
+    lept_set_number(pa, 0.0);
+    EXPECT_TRUE(lept_get_number_array(&w, &n, &len));
+    EXPECT_TRUE(lept_is_equal(&v, &w));
+
+    /* 批量追加 */
+    for (i = 0; i < 40; i++)
+        more[i] = (double)i;
+    lept_append_number_array(&v, more, 40);
+    EXPECT_TRUE(lept_get_number_array(&v, &n, &len));
+    EXPECT_EQ_SIZE_T(56, len);
+    EXPECT_TRUE(lept_get_array_capacity(&v) >= 56);
+    EXPECT_EQ_DOUBLE(39.0, n[55]);
+    lept_shrink_array(&v);
+    EXPECT_EQ_SIZE_T(56, lept_get_array_capacity(&v));
+    lept_set_null(lept_pushback_array_element(&w));
+    lept_append_number_array(&w, more, 2);
+    EXPECT_FALSE(w.flags & LEPT_FLAG_PACKED);
+    EXPECT_EQ_SIZE_T(19, lept_get_array_size(&w));
+    EXPECT_EQ_DOUBLE(1.0, lept_get_number(lept_get_array_element(&w, 18)));
+
+    /* 小数组、超过2^53的整数和混合数组不紧凑存储 */
+    lept_free(&v);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, "[1,2,3]"));
+    EXPECT_FALSE(v.flags & LEPT_FLAG_PACKED);
+    lept_free(&v);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, "[0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,9007199254740993]"));
+    EXPECT_FALSE(v.flags & LEPT_FLAG_PACKED);
+    EXPECT_FALSE(lept_get_number_array(&v, &n, &len));
+    lept_free(&v);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, "[0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,null]"));
+    EXPECT_FALSE(v.flags & LEPT_FLAG_PACKED);
+    lept_free(&v);
+    lept_set_number_array(&v, NULL, 0);
+    EXPECT_TRUE(lept_get_number_array(&v, &n, &len));
+    EXPECT_EQ_SIZE_T(0, len);
+    lept_free(&v);
+    lept_free(&w);
+
+    /* arena中的数组在arena内就地转换，不分配堆内存 */
+    lept_arena_init(&a, 0);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_arena(&v, "[[0,1,-2,3.5,4e2,5,6,7,8,9,10,11,12,13,14,-0.25,16],[1.5],[]]", &a));
+    EXPECT_TRUE(lept_get_number_array(lept_get_array_element(&v, 0), &n, &len));
+    EXPECT_EQ_SIZE_T(17, len);
+    EXPECT_TRUE(memcmp(expect, n, sizeof(expect)) == 0);
+    EXPECT_EQ_DOUBLE(16.0, n[16]);
+    EXPECT_EQ_DOUBLE(16.0, lept_get_array_number(lept_get_array_element(&v, 0), 16));
+    EXPECT_TRUE(lept_get_number_array(lept_get_array_element(&v, 1), &n, &len));
+    EXPECT_TRUE(len == 1 && n[0] == 1.5);
+    EXPECT_TRUE(lept_get_number_array(lept_get_array_element(&v, 2), &n, &len));
+    EXPECT_EQ_SIZE_T(0, len);
+    lept_arena_free(&a);  /* 没有拷贝到堆上的部分，不需要 lept_free */
+}
+
 
 /**
  * @brief 测试对象类型相关接口
@@ -617,11 +1640,224 @@ static void test_access_object() {
 }
 
 
+/**
+ * @brief 测试大对象（带哈希索引）：插入、查找、删除、清空、容量变化、拷贝，以及解析出的大对象
+ * 
+ */
+static void test_access_object_large() {
+    lept_value o, c;
+    char key[16], *json;
+    size_t i, n = 1000, length;
+    lept_arena a;
+    char buf[64 * 16];
+
+    lept_init(&o);
+    lept_set_object(&o, 0);
+    for (i = 0; i < n; i++) {
+        sprintf(key, "k%d", (int)i);
+        lept_set_int64(lept_set_object_value(&o, key, strlen(key)), (int64_t)i);
+    }
+    EXPECT_EQ_SIZE_T(n, lept_get_object_size(&o));
+    lept_set_int64(lept_set_object_value(&o, "k7", 2), 70);  /* 已有的键 */
+    EXPECT_EQ_SIZE_T(n, lept_get_object_size(&o));
+    EXPECT_TRUE(lept_get_int64(lept_find_object_value(&o, "k7", 2)) == 70);
+    EXPECT_EQ_SIZE_T(LEPT_KEY_NOT_EXIST, lept_find_object_index(&o, "k1000", 5));
+    EXPECT_EQ_STRING("k0", lept_get_object_key(&o, 0), lept_get_object_key_length(&o, 0));  /* 保持插入顺序 */
+    EXPECT_EQ_STRING("k999", lept_get_object_key(&o, n - 1), lept_get_object_key_length(&o, n - 1));
+
+    /* 删除后下标前移 */
+    lept_remove_object_value_key(&o, "k0", 2);
+    lept_remove_object_value_index(&o, 100);  /* k101 */
+    EXPECT_EQ_SIZE_T(n - 2, lept_get_object_size(&o));
+    EXPECT_EQ_SIZE_T(LEPT_KEY_NOT_EXIST, lept_find_object_index(&o, "k0", 2));
+    EXPECT_EQ_SIZE_T(LEPT_KEY_NOT_EXIST, lept_find_object_index(&o, "k101", 4));
+    EXPECT_EQ_SIZE_T(0, lept_find_object_index(&o, "k1", 2));
+    EXPECT_EQ_SIZE_T(n - 3, lept_find_object_index(&o, "k999", 4));
+
+    lept_shrink_object(&o);
+    EXPECT_EQ_SIZE_T(n - 2, lept_get_object_capacity(&o));
+    EXPECT_EQ_SIZE_T(99, lept_find_object_index(&o, "k100", 4));
+    lept_reserve_object(&o, 2 * n);
+    EXPECT_EQ_SIZE_T(100, lept_find_object_index(&o, "k102", 4));
+
+    lept_init(&c);
+    lept_copy(&c, &o);
+    EXPECT_TRUE(lept_is_equal(&c, &o));
+    EXPECT_TRUE(lept_get_int64(lept_find_object_value(&c, "k500", 4)) == 500);
+    lept_free(&c);
+
+    lept_clear_object(&o);
+    EXPECT_EQ_SIZE_T(0, lept_get_object_size(&o));
+    EXPECT_EQ_SIZE_T(LEPT_KEY_NOT_EXIST, lept_find_object_index(&o, "k1", 2));
+    lept_set_null(lept_set_object_value(&o, "x", 1));
+    EXPECT_EQ_SIZE_T(0, lept_find_object_index(&o, "x", 1));
+
+    /* 解析出的大对象，包括重复的键（返回第一个） */
+    json = buf;
+    json += sprintf(json, "{\"dup\":1");
+    for (i = 0; i < 40; i++)
+        json += sprintf(json, ",\"k%d\":%d", (int)i, (int)i);
+    sprintf(json, ",\"dup\":2}");
+    lept_free(&o);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&o, buf));
+    {   /* 查找不移动成员，之前取得的指针仍然有效 */
+        const lept_value* first = lept_get_object_value(&o, 0);
+        EXPECT_TRUE(lept_find_object_value(&o, "k39", 3) == lept_get_object_value(&o, 40));
+        EXPECT_TRUE(first == lept_get_object_value(&o, 0));
+    }
+    EXPECT_TRUE(lept_get_int64(lept_find_object_value(&o, "dup", 3)) == 1);
+    EXPECT_TRUE(lept_get_int64(lept_find_object_value(&o, "k39", 3)) == 39);
+    json = lept_stringify(&o, &json, &length) == LEPT_STRINGIFY_OK ? json : NULL;
+    EXPECT_EQ_INT(0, strcmp(buf, json));  /* stringify按原顺序输出 */
+    free(json);
+    lept_arena_init(&a, 0);
+    lept_init(&c);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_arena(&c, buf, &a));
+    EXPECT_TRUE(lept_get_int64(lept_find_object_value(&c, "dup", 3)) == 1);
+    EXPECT_TRUE(lept_get_int64(lept_find_object_value(&c, "k20", 3)) == 20);
+    lept_set_null(lept_set_object_value(&c, "new", 3));  /* 借用的成员数组和键拷贝到堆上 */
+    EXPECT_EQ_SIZE_T(42, lept_find_object_index(&c, "new", 3));
+    EXPECT_TRUE(lept_get_int64(lept_find_object_value(&c, "k20", 3)) == 20);
+    lept_free(&c);
+    lept_arena_free(&a);
+    lept_free(&o);
+}
+
+/**
+ * @brief 测试带位置缓存的查找：键顺序相同的记录直接命中，顺序变化或键不存在时回退
+ * 
+ */
+static void test_access_object_hint() {
+    static const char* records[] = {
+        "{\"id\":1,\"name\":\"a\",\"price\":1.5}",
+        "{\"id\":2,\"name\":\"b\",\"price\":2.5}",
+        "{\"price\":3.5,\"id\":3}",
+        "{\"id\":4}"
+    };
+    static const size_t expect_hint[] = { 2, 2, 0, 0 };
+    lept_value v;
+    size_t i, index, hint = 0;
+    for (i = 0; i < 4; i++) {
+        EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, records[i]));
+        index = lept_find_object_index_hint(&v, "price", 5, &hint);
+        if (i < 3) {
+            EXPECT_EQ_SIZE_T(expect_hint[i], index);
+            EXPECT_EQ_DOUBLE(i + 1.5, lept_get_number(lept_get_object_value(&v, index)));
+        } else
+            EXPECT_EQ_SIZE_T(LEPT_KEY_NOT_EXIST, index);
+        EXPECT_EQ_SIZE_T(expect_hint[i], hint);
+        lept_free(&v);
+    }
+    /* 缓存越界时回退 */
+    hint = 100;
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, records[0]));
+    EXPECT_EQ_SIZE_T(1, lept_find_object_index_hint(&v, "name", 4, &hint));
+    EXPECT_EQ_SIZE_T(1, hint);
+    lept_free(&v);
+}
+
+/**
+ * @brief 测试JSON Pointer：编译一次，对不同文档求值，位置缓存失效时重新查找
+ * 
+ */
+static void test_access_pointer() {
+    lept_pointer p, q, r;
+    lept_value v, w;
+    char key[8];
+    size_t i;
+    lept_init(&w);
+
+    EXPECT_FALSE(lept_pointer_compile(&p, "a/b"));
+    EXPECT_FALSE(lept_pointer_compile(&p, "/a~2"));
+    EXPECT_FALSE(lept_pointer_compile(&p, "/a~"));
+    EXPECT_TRUE(lept_pointer_compile(&p, "/a~1b/~0/01"));
+    EXPECT_EQ_SIZE_T(3, p.count);
+    EXPECT_EQ_STRING("a/b", p.tokens[0].key, p.tokens[0].len);
+    EXPECT_EQ_STRING("~", p.tokens[1].key, p.tokens[1].len);
+    EXPECT_EQ_SIZE_T(LEPT_KEY_NOT_EXIST, p.tokens[2].index);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, "{\"a/b\":{\"~\":{\"01\":true}}}"));
+    EXPECT_EQ_INT(LEPT_TRUE, lept_get_type(lept_pointer_get(&p, &v)));
+    lept_free(&v);
+    lept_pointer_free(&p);
+
+    /* 同结构的文档命中缓存的位置，键顺序不同时重新查找 */
+    EXPECT_TRUE(lept_pointer_compile(&p, "/b/1/c"));
+    EXPECT_TRUE(lept_pointer_compile(&q, ""));
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, "{\"a\":1,\"b\":[0,{\"x\":0,\"c\":\"s\"}]}"));
+    EXPECT_EQ_STRING("s", lept_get_string(lept_pointer_get(&p, &v)), lept_get_string_length(lept_pointer_get(&p, &v)));
+    EXPECT_EQ_SIZE_T(1, p.tokens[0].hint);
+    EXPECT_EQ_SIZE_T(1, p.tokens[2].hint);
+    EXPECT_TRUE(lept_pointer_get(&q, &v) == &v);
+    lept_free(&v);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, "{\"b\":[0,{\"c\":2}],\"a\":1}"));
+    EXPECT_EQ_DOUBLE(2.0, lept_get_number(lept_pointer_get(&p, &v)));
+    EXPECT_EQ_SIZE_T(0, p.tokens[0].hint);
+    EXPECT_EQ_SIZE_T(0, p.tokens[2].hint);
+    lept_free(&v);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, "{\"b\":[0],\"c\":{}}"));
+    EXPECT_TRUE(lept_pointer_get(&p, &v) == NULL);
+    lept_free(&v);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, "{\"b\":{\"1\":{\"c\":null}}}"));
+    EXPECT_EQ_INT(LEPT_NULL, lept_get_type(lept_pointer_get(&p, &v)));
+    lept_free(&v);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, "{\"b\":[0,5]}"));
+    EXPECT_TRUE(lept_pointer_get(&p, &v) == NULL);
+    lept_free(&v);
+    lept_pointer_free(&q);
+
+    /* 懒惰解析的容器在路过时展开；紧凑的数字数组取元素 */
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_lazy(&v, "{\"x\":[],\"b\":[0,{\"c\":[0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15]}]}"));
+    EXPECT_TRUE(lept_pointer_compile(&q, "/b/1/c/15"));
+    EXPECT_TRUE(lept_pointer_get(&p, &v)->flags & LEPT_FLAG_LAZY);  /* 终点本身不展开 */
+    EXPECT_EQ_DOUBLE(15.0, lept_get_number(lept_pointer_get(&q, &v)));
+    EXPECT_EQ_SIZE_T(16, lept_get_array_size(lept_pointer_get(&p, &v)));
+    lept_free(&v);
+    lept_pointer_free(&p);
+    lept_pointer_free(&q);
+
+    /* 有哈希索引的对象用预先算好的哈希值查找 */
+    lept_set_object(&w, 0);
+    for (i = 0; i < 40; i++) {
+        sprintf(key, "k%u", (unsigned)i);
+        lept_set_number(lept_set_object_value(&w, key, strlen(key)), (double)i);
+    }
+    EXPECT_TRUE(lept_pointer_compile(&p, "/k33"));
+    EXPECT_EQ_DOUBLE(33.0, lept_get_number(lept_pointer_get(&p, &w)));
+    lept_remove_object_value_key(&w, "k0", 2);
+    EXPECT_EQ_DOUBLE(33.0, lept_get_number(lept_pointer_get(&p, &w)));
+    EXPECT_EQ_SIZE_T(32, p.tokens[0].hint);
+    lept_pointer_free(&p);
+
+    /* 写入：创建缺少的成员，"-" 追加数组元素 */
+    lept_free(&w);
+    EXPECT_TRUE(lept_pointer_compile(&p, "/a/b/-"));
+    EXPECT_TRUE(lept_pointer_compile(&q, "/a/b/1/c"));
+    EXPECT_TRUE(lept_pointer_compile(&r, "/a/b/0/x"));
+    lept_set_number(lept_pointer_set(&p, &w), 1.0);
+    lept_set_string(lept_pointer_set(&q, &w), "y", 1);  /* 下标等于长度时追加 */
+    EXPECT_TRUE(lept_pointer_set(&r, &w) == NULL);      /* 经过标量 */
+    lept_pointer_free(&r);
+    EXPECT_TRUE(lept_pointer_compile(&r, "/a/b/3"));
+    EXPECT_TRUE(lept_pointer_set(&r, &w) == NULL);      /* 越界 */
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, "{\"a\":{\"b\":[1,{\"c\":\"y\"}]}}"));
+    EXPECT_TRUE(lept_is_equal(&v, &w));
+    lept_free(&v);
+    lept_free(&w);
+    lept_pointer_free(&p);
+    lept_pointer_free(&q);
+    lept_pointer_free(&r);
+}
+
+
 /**
  * @brief: 测试把 JSON 值转换为数字类型字符串
  * @notes: 这里用到了往返测试，即先将原始字符串解析为JSON值，再stringfy为目标字符串，比较两个字符串是否一致 
  */
 static void test_stringify_number() {
+    double special[4];
+    lept_value v;
+    char* json;
+    size_t i, length;
     TEST_ROUNDTRIP("0");
     TEST_ROUNDTRIP("-0");
     TEST_ROUNDTRIP("1");
@@ -634,14 +1870,108 @@ static void test_stringify_number() {
     TEST_ROUNDTRIP("1.234e-20");
 
     TEST_ROUNDTRIP("1.0000000000000002"); /* the smallest number > 1 */
-    TEST_ROUNDTRIP("4.9406564584124654e-324"); /* minimum denormal */
-    TEST_ROUNDTRIP("-4.9406564584124654e-324");
-    TEST_ROUNDTRIP("2.2250738585072009e-308");  /* Max subnormal double */
-    TEST_ROUNDTRIP("-2.2250738585072009e-308");
+    TEST_ROUNDTRIP("5e-324"); /* minimum denormal */
+    TEST_ROUNDTRIP("-5e-324");
+    TEST_ROUNDTRIP("2.225073858507201e-308");  /* Max subnormal double */
+    TEST_ROUNDTRIP("-2.225073858507201e-308");
     TEST_ROUNDTRIP("2.2250738585072014e-308");  /* Min normal positive double */
     TEST_ROUNDTRIP("-2.2250738585072014e-308");
     TEST_ROUNDTRIP("1.7976931348623157e+308");  /* Max double */
     TEST_ROUNDTRIP("-1.7976931348623157e+308");
+
+    /* 最短表示 */
+    TEST_ROUNDTRIP("0.1");
+    TEST_ROUNDTRIP("0.3");
+    TEST_ROUNDTRIP("-123.456");
+    TEST_ROUNDTRIP("0.0001");
+    TEST_ROUNDTRIP("1e-5");
+    TEST_ROUNDTRIP("9007199254740992");  /* 2^53 */
+    TEST_ROUNDTRIP("12345678901234568");
+    TEST_ROUNDTRIP("1e+17");
+    TEST_ROUNDTRIP("1.2345678901234568e+20");
+    TEST_ROUNDTRIP("5e-310");
+
+    /* 无穷大和NaN没有JSON表示，与 JSON.stringify 一样输出 null */
+    special[0] = HUGE_VAL;
+    special[1] = -HUGE_VAL;
+    special[2] = HUGE_VAL - HUGE_VAL;
+    special[3] = -special[2];
+    lept_init(&v);
+    for (i = 0; i < 4; i++) {
+        lept_set_number(&v, special[i]);
+        EXPECT_EQ_INT(LEPT_STRINGIFY_OK, lept_stringify(&v, &json, &length));
+        EXPECT_EQ_STRING("null", json, length);
+        free(json);
+    }
+
+    /* 整数按整数格式化，不丢失精度 */
+    TEST_ROUNDTRIP("9007199254740993");
+    TEST_ROUNDTRIP("-9223372036854775808");
+    TEST_ROUNDTRIP("18446744073709551615");
+    TEST_ROUNDTRIP("[1,-2,12345678901234567890]");
+}
+
+
+/**
+ * @brief 随机测试数字格式化：结果能精确还原，且不长于 "%.17g"
+ * 
+ */
+static void test_stringify_number_random() {
+    char buf[32];
+    char* json;
+    size_t i, length;
+    int bad = 0;
+    double d, actual;
+    lept_value v;
+    lept_init(&v);
+    for (i = 0; i < 50000; i++) {
+        unsigned long long bits = random_next();
+        if (i % 2)  /* 一半是较小的整数和短小数 */
+            bits = random_next() % 2 ? (unsigned long long)(random_next() % 100000000) : (unsigned long long)(random_next() % 1000) * 1000;
+        memcpy(&d, &bits, sizeof(d));
+        if (i % 2)
+            d = i % 4 == 1 ? (double)bits : (double)bits / 1000;
+        if (d != d || d == HUGE_VAL || d == -HUGE_VAL)
+            continue;
+        lept_set_number(&v, d);
+        lept_stringify(&v, &json, &length);
+        sprintf(buf, "%.17g", d);
+        actual = strtod(json, NULL);
+        if (memcmp(&actual, &d, sizeof(d)) != 0 || length > strlen(buf)) {
+            fprintf(stderr, "stringify mismatch: %s %s\n", json, buf);
+            bad++;
+        }
+        free(json);
+    }
+    EXPECT_EQ_INT(0, bad);
+}
+
+
+/* 随机字符串：需要转义的字节、UTF-8多字节字符和普通字节混合，长度跨越多个块 */
+static void test_stringify_string_random() {
+    static const char* pieces[] = { "a", "bcdefgh", "\"", "\\", "\n", "\x01", "\x1F", "\x7F", "\xC3\xA9", "\xE4\xB8\xAD", "/" };
+    char str[512];
+    lept_value v, w;
+    char* out;
+    size_t len, n;
+    int i;
+    lept_init(&w);
+    for (i = 0; i < 500; i++) {
+        for (len = 0; len < 400; len += n) {
+            const char* p = pieces[random_next() % (sizeof(pieces) / sizeof(pieces[0]))];
+            memcpy(str + len, p, n = strlen(p));
+        }
+        len = random_next() % (len + 1);
+        lept_init(&v);
+        lept_set_string(&v, str, len);
+        EXPECT_EQ_INT(LEPT_STRINGIFY_OK, lept_stringify(&v, &out, &n));
+        EXPECT_EQ_SIZE_T(n, lept_stringify_size(&v));
+        EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&w, out));
+        EXPECT_TRUE(lept_is_equal(&v, &w));
+        free(out);
+        lept_free(&v);
+        lept_free(&w);
+    }
 }
 
 
@@ -655,6 +1985,8 @@ static void test_stringify_string() {
     TEST_ROUNDTRIP("\"Hello\\nWorld\"");
     TEST_ROUNDTRIP("\"\\\" \\\\ / \\b \\f \\n \\r \\t\"");
     TEST_ROUNDTRIP("\"Hello\\u0000World\"");
+    TEST_ROUNDTRIP("\"0123456789abcdef0123456789abcde\\\"0123456789abcdef\\u001F\\\\\"");  /* 跨越16/32字节的块 */
+    test_stringify_string_random();
 }
 
 
@@ -679,6 +2011,209 @@ static void test_stringify_object() {
 }
 
 
+/* 流式输出的写回调：收集输出，记录单次写出的最大长度；limit 之后返回失败 */
+typedef struct {
+    char* buf;
+    size_t len, max, limit;
+} test_sink;
+
+static int test_sink_write(void* user, const char* buf, size_t len) {
+    test_sink* k = (test_sink*)user;
+    if (k->len + len > k->limit)
+        return FALSE;
+    k->buf = (char*)realloc(k->buf, k->len + len);
+    memcpy(k->buf + k->len, buf, len);
+    k->len += len;
+    if (len > k->max)
+        k->max = len;
+    return TRUE;
+}
+
+/**
+ * @brief 测试流式生成：分批写出的内容与 lept_stringify 一致，缓冲区不随文档增长
+ * 
+ */
+static void test_stringify_stream() {
+    static char str[20000];
+    test_sink k;
+    lept_value v, *o;
+    char* out, *pretty, buf[256];
+    size_t len, plen, i;
+    FILE* fp;
+    for (i = 0; i < sizeof(str); i++)
+        str[i] = "ab\"\\\n\x01c"[i % 7];
+    lept_init(&v);
+    lept_set_array(&v, 0);
+    for (i = 0; i < 3000; i++) {
+        o = lept_pushback_array_element(&v);
+        lept_set_object(o, 0);
+        lept_set_number(lept_set_object_value(o, "n", 1), i * 0.5);
+        lept_set_string(lept_set_object_value(o, "s", 1), str, i % 1000 == 0 ? sizeof(str) : i % 50);
+    }
+    EXPECT_EQ_INT(LEPT_STRINGIFY_OK, lept_stringify(&v, &out, &len));
+
+    memset(&k, 0, sizeof(k));
+    k.limit = (size_t)-1;
+    EXPECT_EQ_INT(LEPT_STRINGIFY_OK, lept_stringify_to(&v, test_sink_write, &k, 1024, 0));
+    EXPECT_TRUE(k.len == len && memcmp(k.buf, out, len) == 0);
+    EXPECT_TRUE(k.max <= 1024);  /* 长字符串分段转义，缓冲区不增长 */
+    free(k.buf);
+
+    /* 写回调失败时中止 */
+    memset(&k, 0, sizeof(k));
+    k.limit = len / 2;
+    EXPECT_EQ_INT(LEPT_STRINGIFY_WRITE_FAILED, lept_stringify_to(&v, test_sink_write, &k, 0, 0));
+    EXPECT_TRUE(k.len <= len / 2 && memcmp(k.buf, out, k.len) == 0);
+    free(k.buf);
+
+    /* 美化输出与 lept_stringify_pretty 相同 */
+    EXPECT_EQ_INT(LEPT_STRINGIFY_OK, lept_stringify_pretty(&v, &pretty, &plen, LEPT_PRETTY_INDENT(2) | LEPT_PRETTY_CRLF));
+    memset(&k, 0, sizeof(k));
+    k.limit = (size_t)-1;
+    EXPECT_EQ_INT(LEPT_STRINGIFY_OK, lept_stringify_to(&v, test_sink_write, &k, 1024, LEPT_PRETTY_INDENT(2) | LEPT_PRETTY_CRLF));
+    EXPECT_TRUE(k.len == plen && memcmp(k.buf, pretty, plen) == 0);
+    free(k.buf);
+    free(pretty);
+
+    /* 写到文件 */
+    if ((fp = tmpfile()) != NULL) {
+        EXPECT_EQ_INT(LEPT_STRINGIFY_OK, lept_stringify_file(&v, fp, 0));
+        EXPECT_EQ_SIZE_T(len, (size_t)ftell(fp));
+        rewind(fp);
+        EXPECT_EQ_SIZE_T(sizeof(buf), fread(buf, 1, sizeof(buf), fp));
+        EXPECT_TRUE(memcmp(buf, out, sizeof(buf)) == 0);
+        fclose(fp);
+    }
+    free(out);
+    lept_free(&v);
+}
+
+
+/**
+ * @brief 测试可重复使用的输出缓冲区，以及生成到调用者的缓冲区（准确长度和放不下时）
+ * 
+ */
+static void test_stringify_writer() {
+    static const char* docs[] = {
+        "{\"id\":1,\"tags\":[\"a\\u0001\\n\",\"b\"],\"price\":-1.25e-6,\"big\":18446744073709551615}",
+        "[0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15.5]",
+        "\"\\\"\\\\\\b\\f\\r\\t\\u001F\"",
+        "[]"
+    };
+    lept_writer w;
+    lept_value v;
+    char* out, *buf, *wbuf = NULL;
+    size_t i, j, len, size, wsize = 0;
+    lept_writer_init(&w);
+    for (i = 0; i < 8; i++) {
+        const char* json = docs[i % 4];
+        EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, json));
+        EXPECT_EQ_INT(LEPT_STRINGIFY_OK, lept_stringify_writer(&v, &w));
+        EXPECT_TRUE(w.len == strlen(json) && memcmp(json, w.buf, w.len) == 0);
+        EXPECT_EQ_INT('\0', w.buf[w.len]);
+        if (i >= 4)  /* 第一轮之后容量足够，不再分配 */
+            EXPECT_TRUE(w.buf == wbuf && w.size == wsize);
+        wbuf = w.buf;
+        wsize = w.size;
+
+        /* 按准确长度分配，多写一个字节也会被检查出来 */
+        EXPECT_EQ_SIZE_T(strlen(json), lept_stringify_size(&v));
+        buf = (char*)malloc(size = lept_stringify_size(&v) + 1);
+        EXPECT_EQ_INT(LEPT_STRINGIFY_OK, lept_stringify_buffer(&v, buf, size, &len));
+        EXPECT_TRUE(len == strlen(json) && memcmp(json, buf, len + 1) == 0);
+        free(buf);
+
+        /* 缓冲区小一个字节以上时返回错误，不越界 */
+        for (j = 0; j < size; j++) {
+            buf = (char*)malloc(j ? j : 1);
+            EXPECT_EQ_INT(LEPT_STRINGIFY_BUFFER_TOO_SMALL, lept_stringify_buffer(&v, buf, j, NULL));
+            free(buf);
+        }
+        lept_free(&v);
+    }
+    lept_writer_free(&w);
+
+    /* 懒惰解析的文档 */
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_lazy(&v, docs[0]));
+    EXPECT_EQ_INT(LEPT_STRINGIFY_OK, lept_stringify(&v, &out, &len));
+    EXPECT_EQ_SIZE_T(len, lept_stringify_size(&v));
+    free(out);
+    lept_free(&v);
+}
+
+
+/**
+ * @brief 测试美化输出，以及不建树的文本压缩和重新排版
+ * 
+ */
+static void test_stringify_pretty() {
+    static const char* json = "{\"a\":[1,2,{}],\"b\":{\"c\":\"x y\",\"d\":[]},\"e\":null}";
+    static const char* pretty =
+        "{\n  \"a\": [\n    1,\n    2,\n    {}\n  ],\n  \"b\": {\n    \"c\": \"x y\",\n    \"d\": []\n  },\n  \"e\": null\n}";
+    static const char* tabs =
+        "{\r\n\t\"a\": [\r\n\t\t1,\r\n\t\t2,\r\n\t\t{}\r\n\t],\r\n\t\"b\": {\r\n\t\t\"c\": \"x y\",\r\n\t\t\"d\": []\r\n\t},\r\n\t\"e\": null\r\n}";
+    static char buf[1 << 16];
+    lept_writer w;
+    lept_value v, u;
+    char* out, *min;
+    size_t len, n;
+    int i;
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, json));
+    EXPECT_EQ_INT(LEPT_STRINGIFY_OK, lept_stringify_pretty(&v, &out, &len, LEPT_PRETTY_INDENT(2)));
+    EXPECT_TRUE(len == strlen(pretty) && memcmp(out, pretty, len) == 0);
+    free(out);
+    EXPECT_EQ_INT(LEPT_STRINGIFY_OK, lept_stringify_pretty(&v, &out, &len, LEPT_PRETTY_TABS | LEPT_PRETTY_CRLF));
+    EXPECT_TRUE(len == strlen(tabs) && memcmp(out, tabs, len) == 0);
+    free(out);
+    EXPECT_EQ_INT(LEPT_STRINGIFY_OK, lept_stringify_pretty(&v, &out, &len, LEPT_PRETTY_INDENT(4)));
+    EXPECT_TRUE(lept_parse(&u, out) == LEPT_PARSE_OK && lept_is_equal(&u, &v));
+    free(out);
+    lept_free(&u);
+    lept_free(&v);
+
+    /* 文本重新排版与建树后生成的结果相同；压缩是它的逆过程 */
+    lept_writer_init(&w);
+    w.flags = LEPT_PRETTY_INDENT(2);
+    lept_prettify(json, strlen(json), &w);
+    EXPECT_TRUE(w.len == strlen(pretty) && memcmp(w.buf, pretty, w.len) == 0);
+    w.flags = LEPT_PRETTY_TABS | LEPT_PRETTY_CRLF;
+    lept_prettify(pretty, strlen(pretty), &w);
+    EXPECT_TRUE(w.len == strlen(tabs) && memcmp(w.buf, tabs, w.len) == 0);
+    EXPECT_EQ_SIZE_T(strlen(json), lept_minify(w.buf, w.len, buf));
+    EXPECT_TRUE(memcmp(buf, json, strlen(json)) == 0);
+    w.flags = 0;
+    lept_prettify(" [ 1 , \"a\\\" b\" ,[ ] ] ", 22, &w);
+    EXPECT_EQ_STRING("[1,\"a\\\" b\",[]]", w.buf, w.len);
+    EXPECT_EQ_SIZE_T(3, lept_minify(" \" a", 4, buf));  /* 字符串不闭合时保留到结尾 */
+    EXPECT_TRUE(memcmp(buf, "\" a", 3) == 0);
+
+    /* 随机文档：就地压缩，字符串跨越64字节的块 */
+    for (i = 0; i < 500; i++) {
+        len = 0;
+        random_json(buf, &len, 2);
+        buf[len] = '\0';
+        EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, buf));
+        w.flags = LEPT_PRETTY_INDENT(i % 5);
+        lept_prettify(buf, len, &w);
+        EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&u, w.buf));
+        EXPECT_TRUE(lept_is_equal(&u, &v));
+        lept_free(&u);
+        min = (char*)malloc(w.len + 1);
+        n = lept_minify(w.buf, w.len, min);
+        n = lept_minify(min, n, min);
+        min[n] = '\0';
+        EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&u, min));
+        EXPECT_TRUE(lept_is_equal(&u, &v));
+        EXPECT_EQ_SIZE_T(n, lept_minify(buf, len, buf));
+        EXPECT_TRUE(memcmp(buf, min, n) == 0);
+        free(min);
+        lept_free(&u);
+        lept_free(&v);
+    }
+    lept_writer_free(&w);
+}
+
+
 /**
  * @brief JSON文本生成器集成测试
  * 
@@ -688,9 +2223,13 @@ static void test_stringify() {
     TEST_ROUNDTRIP("false");
     TEST_ROUNDTRIP("true");
     test_stringify_number();
+    test_stringify_number_random();
     test_stringify_string();
     test_stringify_array();
     test_stringify_object();
+    test_stringify_stream();
+    test_stringify_writer();
+    test_stringify_pretty();
 }
 
 
@@ -706,6 +2245,13 @@ static void test_is_euqal() {
     TEST_EQUAL("null", "0", 0);
     TEST_EQUAL("123", "123", 1);
     TEST_EQUAL("123", "456", 0);
+    TEST_EQUAL("123", "123.0", 1);  /* 整数与浮点数按数值比较 */
+    TEST_EQUAL("123", "1.23e2", 1);
+    TEST_EQUAL("-1", "18446744073709551615", 0);
+    TEST_EQUAL("9007199254740993", "9007199254740992", 0);
+    TEST_EQUAL("9007199254740993", "9007199254740993.0", 0);  /* 浮点数是 2^53 */
+    TEST_EQUAL("18446744073709551615", "18446744073709551615", 1);
+    TEST_EQUAL("1", "1.5", 0);
     TEST_EQUAL("\"abc\"", "\"abc\"", 1);
     TEST_EQUAL("\"abc\"", "\"abcd\"", 0);
     TEST_EQUAL("[]", "[]", 1);
@@ -817,22 +2363,41 @@ int main() {
     // 测试解析器
     test_parse_literal();
     test_parse_number();
+    test_parse_number_random();
+    test_parse_int64();
     test_parse_invalid_num();
     test_parse_string();
     test_parse_invalid_str();
     test_parse_invalid_unicode();
+    test_parse_long_run();
     test_parse_array();
     test_parse_invalid_array();
     test_parse_object();
     test_parse_invalid_obj();
+    test_parse_n();
+    test_parse_sax();
+    test_parse_stream();
+    test_parse_insitu();
+    test_parse_arena();
+    test_parse_keypool();
+    test_parse_lazy();
+    test_skip_value();
+    test_validate();
+    test_parse_projected();
 
     // 测试access接口
     test_access_null();
     test_access_boolean();
     test_access_number();
     test_access_string();
+    test_access_compact();
+    test_access_short_string();
     test_access_arrary();
+    test_access_number_array();
     test_access_object();
+    test_access_object_large();
+    test_access_object_hint();
+    test_access_pointer();
 
     // 测试生成器
     test_stringify();